@@ -0,0 +1,51 @@
+// Limbs per nanosecond of in-place += and -= for 10^2 to 10^6-limb operands.
+// Build: g++ -std=c++20 -O2 -I.. add_sub.cpp -o add_sub
+// Add -DBIGINTEGER_NO_SIMD for the portable kernels, -DBIGINTEGER_BINARY_LIMBS for 64-bit limbs.
+#include "biginteger.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+
+#ifdef BIGINTEGER_BINARY_LIMBS
+constexpr double kDigitsPerLimb = 64 * 0.30102999566398120;
+#else
+constexpr double kDigitsPerLimb = 9;
+#endif
+
+BigInteger RandomNumber(size_t limbs, std::mt19937_64& rng) {
+  std::string str(static_cast<size_t>(std::floor(static_cast<double>(limbs) * kDigitsPerLimb)), '0');
+  for (char& digit : str) {
+    digit = static_cast<char>('0' + rng() % 10);
+  }
+  str[0] = '9';
+  return BigInteger(str);
+}
+
+int main() {
+  std::mt19937_64 rng(7);
+
+  std::cout << "limbs\tadd limbs/ns\tsub limbs/ns\n";
+  for (size_t limbs = 100; limbs <= 1000000; limbs *= 10) {
+    BigInteger a = RandomNumber(limbs, rng);
+    BigInteger b = RandomNumber(limbs, rng) / 2;
+    size_t repeats = 20000000 / limbs;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < repeats; ++i) {
+      a += b;
+    }
+    double add = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < repeats; ++i) {
+      a -= b;
+    }
+    double sub = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << limbs << "\t" << static_cast<double>(limbs * repeats) / add << "\t"
+              << static_cast<double>(limbs * repeats) / sub << "\n";
+  }
+}
@@ -0,0 +1,95 @@
+// Division- and product-heavy rounds with limbs from the default heap, from a monotonic
+// arena dropped after every round, and from a StackStorage behind AllocatorResource.
+// Build: g++ -std=c++20 -O2 -I.. arena.cpp -o arena
+#include "biginteger.h"
+#include "../../StackAllocator/stackallocator.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+constexpr size_t kStackBytes = size_t(1) << 24;
+
+BigInteger RandomNumber(size_t digits) {
+  std::string str;
+  for (size_t i = 0; i < digits; ++i) {
+    str += static_cast<char>('1' + rand() % 9);
+  }
+  return BigInteger(str);
+}
+
+// Many mid-sized temporaries per iteration: quotients, remainders and their products.
+BigInteger Round(const std::vector<BigInteger>& numbers, const BigInteger& divisor) {
+  BigInteger acc;
+  for (const BigInteger& number : numbers) {
+    BigInteger quotient = number / divisor;
+    acc += quotient * quotient % divisor;
+    acc -= number % (divisor + 1);
+  }
+  return acc;
+}
+
+template <typename Function>
+void Run(const std::string& name, size_t rounds, Function function) {
+  auto start = std::chrono::steady_clock::now();
+  BigInteger result = function(rounds);
+  double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  std::cout << name << "\t" << ms / static_cast<double>(rounds) << " ms/round\t" << result.bit_length()
+            << " result bits\n";
+}
+
+int main(int argc, char** argv) {
+  size_t rounds = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200);
+
+  // Numbers of tens of digits, where an allocation costs as much as the arithmetic, then hundreds.
+  for (size_t digits : {60, 600}) {
+    std::vector<BigInteger> numbers;
+    for (size_t i = 0; i < 50; ++i) {
+      numbers.push_back(RandomNumber(digits + digits / 15 * i));
+    }
+    BigInteger divisor = RandomNumber(digits / 2);
+    size_t count = rounds * 600 / digits;
+    std::cout << digits << " to " << digits * 13 / 3 << " digits:\n";
+
+    Run("heap", count, [&](size_t round_count) {
+      BigInteger result;
+      for (size_t i = 0; i < round_count; ++i) {
+        result += Round(numbers, divisor);
+      }
+      return result;
+    });
+
+    Run("monotonic arena", count, [&](size_t round_count) {
+      std::vector<char> buffer(kStackBytes);
+      BigInteger result;
+      for (size_t i = 0; i < round_count; ++i) {
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+        std::pmr::memory_resource* previous = BigInteger::set_memory_resource(&arena);
+        BigInteger value = Round(numbers, divisor);
+        BigInteger::set_memory_resource(previous);
+        result += value;
+      }
+      return result;
+    });
+
+    Run("StackStorage", count, [&](size_t round_count) {
+      auto storage = std::make_unique<StackStorage<kStackBytes>>();
+      BigInteger result;
+      for (size_t i = 0; i < round_count; ++i) {
+        // Rewinding the storage drops everything the previous round allocated.
+        storage->top_ = storage->data_;
+        storage->size_ = kStackBytes;
+        AllocatorResource<StackAllocator<char, kStackBytes>> resource{StackAllocator<char, kStackBytes>(*storage)};
+        std::pmr::memory_resource* previous = BigInteger::set_memory_resource(&resource);
+        BigInteger value = Round(numbers, divisor);
+        BigInteger::set_memory_resource(previous);
+        result += value;
+      }
+      return result;
+    });
+  }
+}
@@ -0,0 +1,99 @@
+// Nanoseconds per element of a loop of operator* against multiply_batch for 4- to 32-limb pairs,
+// then ModContext::multiply and powmod in a loop against their batched forms.
+// Build: g++ -std=c++20 -O2 -I.. batch.cpp -o batch
+// Add -DBIGINTEGER_NO_SIMD for the portable kernel, -DBIGINTEGER_BINARY_LIMBS for 64-bit limbs.
+#include "biginteger.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef BIGINTEGER_BINARY_LIMBS
+constexpr double kDigitsPerLimb = 64 * 0.30102999566398120;
+#else
+constexpr double kDigitsPerLimb = 9;
+#endif
+
+constexpr size_t kCount = 4096;
+
+BigInteger RandomNumber(size_t limbs, std::mt19937_64& rng) {
+  std::string str(static_cast<size_t>(std::floor(static_cast<double>(limbs) * kDigitsPerLimb)), '0');
+  for (char& digit : str) {
+    digit = static_cast<char>('0' + rng() % 10);
+  }
+  str[0] = '9';
+  return BigInteger(str);
+}
+
+std::vector<BigInteger> RandomNumbers(size_t limbs, std::mt19937_64& rng) {
+  std::vector<BigInteger> numbers;
+  for (size_t i = 0; i < kCount; ++i) {
+    numbers.push_back(RandomNumber(limbs, rng));
+  }
+  return numbers;
+}
+
+template <typename Function>
+double NanosecondsPerElement(size_t count, size_t repeats, Function function) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < repeats; ++i) {
+    function();
+  }
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  return ns / static_cast<double>(count * repeats);
+}
+
+int main() {
+  std::mt19937_64 rng(7);
+  std::vector<BigInteger> result(kCount);
+
+  std::cout << "limbs\tloop ns\tbatch ns\n";
+  for (size_t limbs : {4, 8, 16, 32}) {
+    std::vector<BigInteger> big_ints1 = RandomNumbers(limbs, rng);
+    std::vector<BigInteger> big_ints2 = RandomNumbers(limbs, rng);
+    size_t repeats = 2000 / limbs;
+
+    double loop = NanosecondsPerElement(kCount, repeats, [&]() {
+      for (size_t i = 0; i < kCount; ++i) {
+        result[i] = big_ints1[i] * big_ints2[i];
+      }
+    });
+    double batch = NanosecondsPerElement(kCount, repeats, [&]() {
+      BigInteger::multiply_batch(big_ints1, big_ints2, result);
+    });
+    std::cout << limbs << "\t" << loop << "\t" << batch << "\n";
+  }
+
+  std::cout << "\nmodulus limbs\tmultiply loop ns\tbatch ns\tpowmod loop ns\tbatch ns\n";
+  for (size_t limbs : {4, 16}) {
+    BigInteger modulus = RandomNumber(limbs, rng) + 1;
+    ModContext context(modulus);
+    std::vector<BigInteger> big_ints1 = RandomNumbers(limbs, rng);
+    std::vector<BigInteger> big_ints2 = RandomNumbers(limbs, rng);
+    size_t repeats = 400 / limbs;
+
+    double multiply_loop = NanosecondsPerElement(kCount, repeats, [&]() {
+      for (size_t i = 0; i < kCount; ++i) {
+        result[i] = context.multiply(big_ints1[i], big_ints2[i]);
+      }
+    });
+    double multiply_batch = NanosecondsPerElement(kCount, repeats, [&]() {
+      context.multiply_batch(big_ints1, big_ints2, result);
+    });
+
+    std::vector<BigInteger> exponents(big_ints2.begin(), big_ints2.begin() + kCount / 16);
+    double pow_loop = NanosecondsPerElement(exponents.size(), 1, [&]() {
+      for (size_t i = 0; i < exponents.size(); ++i) {
+        result[i] = powmod(big_ints1[i], exponents[i], modulus);
+      }
+    });
+    double pow_batch = NanosecondsPerElement(exponents.size(), 1, [&]() {
+      BigInteger::powmod_batch(std::span(big_ints1).first(exponents.size()), exponents, modulus, result);
+    });
+    std::cout << limbs << "\t" << multiply_loop << "\t" << multiply_batch << "\t" << pow_loop << "\t" << pow_batch
+              << "\n";
+  }
+}
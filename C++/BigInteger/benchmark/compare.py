@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""Compares two suite.cpp JSON outputs and flags benchmarks that got slower.
+
+Usage: compare.py [baseline.json] current.json [threshold]
+
+Without a baseline, the stored baseline_<backend>.json next to this script is taken for the
+backend current.json records. threshold is the tolerated relative slowdown, 0.10 by default.
+The exit status is 1 when any benchmark present in both files is slower than that, so the
+script can gate a build.
+"""
+import json
+import os
+import sys
+
+
+def load(path):
+    with open(path) as file:
+        data = json.load(file)
+    return data["backend"], {bench["name"]: bench["ns_per_op"] for bench in data["benchmarks"]}
+
+
+def is_number(text):
+    try:
+        float(text)
+    except ValueError:
+        return False
+    return True
+
+
+def stored_baseline(current_path):
+    with open(current_path) as file:
+        backend = json.load(file)["backend"]
+    return os.path.join(os.path.dirname(os.path.abspath(__file__)), f"baseline_{backend}.json")
+
+
+def main():
+    args = sys.argv[1:]
+    threshold = 0.10
+    if len(args) in (2, 3) and is_number(args[-1]):
+        threshold = float(args.pop())
+    if len(args) == 1:
+        args.insert(0, stored_baseline(args[0]))
+    if len(args) != 2:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+
+    baseline_backend, baseline = load(args[0])
+    current_backend, current = load(args[1])
+    if baseline_backend != current_backend:
+        print(f"backends differ: {baseline_backend} baseline, {current_backend} current", file=sys.stderr)
+        return 2
+
+    slower = []
+    print(f"{'benchmark':<28}{'baseline ns':>16}{'current ns':>16}{'change':>10}")
+    for name, ns in current.items():
+        if name not in baseline:
+            print(f"{name:<28}{'-':>16}{ns:>16.1f}{'new':>10}")
+            continue
+        change = ns / baseline[name] - 1
+        flag = ""
+        if change > threshold:
+            flag = "  SLOWER"
+            slower.append(name)
+        print(f"{name:<28}{baseline[name]:>16.1f}{ns:>16.1f}{change:>+10.1%}{flag}")
+
+    for name in baseline.keys() - current.keys():
+        print(f"{name:<28}{baseline[name]:>16.1f}{'-':>16}{'missing':>10}")
+
+    if slower:
+        print(f"\n{len(slower)} benchmark(s) slower than the baseline by more than {threshold:.0%}")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,45 @@
+// Decimal parsing and printing throughput of both limb backends.
+// Build: g++ -std=c++20 -O2 -I.. conversion.cpp -o conversion
+#include "biginteger.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+template <typename Limbs>
+void Run(const std::string& name, const std::string& digits) {
+  using Clock = std::chrono::steady_clock;
+
+  auto start = Clock::now();
+  BasicBigInteger<Limbs> big_int;
+  BasicBigInteger<Limbs>::from_chars(digits.data(), digits.data() + digits.size(), big_int);
+  auto parsed = Clock::now();
+
+  std::string str(BasicBigInteger<Limbs>::max_chars(big_int), '\0');
+  auto result = BasicBigInteger<Limbs>::to_chars(str.data(), str.data() + str.size(), big_int);
+  auto printed = Clock::now();
+
+  str.resize(static_cast<size_t>(result.ptr - str.data()));
+  std::cout << name << "\t" << digits.size() << "\t"
+            << std::chrono::duration<double, std::milli>(parsed - start).count() << "\t"
+            << std::chrono::duration<double, std::milli>(printed - parsed).count() << "\t"
+            << (str == digits ? "ok" : "MISMATCH") << "\n";
+}
+
+int main(int argc, char** argv) {
+  size_t max_digits = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000);
+
+  std::cout << "backend\tdigits\tfrom_chars ms\tto_chars ms\n";
+  for (size_t size = 1000; size <= max_digits; size *= 10) {
+    std::string digits;
+    digits.reserve(size);
+    digits += static_cast<char>('1' + rand() % 9);
+    while (digits.size() < size) {
+      digits += static_cast<char>('0' + rand() % 10);
+    }
+
+    Run<DecimalLimbs>("decimal", digits);
+    Run<BinaryLimbs>("binary", digits);
+  }
+}
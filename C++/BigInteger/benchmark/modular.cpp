@@ -0,0 +1,79 @@
+// powmod through ModContext against square-and-multiply with * and %,
+// plus modinv, for 512 to 8192-bit moduli; is_probable_prime runs on the Mersenne
+// prime closest to each size.
+// Build: g++ -std=c++20 -O2 -I.. modular.cpp -o modular
+#include "biginteger.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+BigInteger RandomBits(size_t bits, std::mt19937_64& rng) {
+  BigInteger result = 0;
+  for (size_t i = 0; i < bits; i += 32) {
+    result = result * BigInteger(1 << 16) * BigInteger(1 << 16) + BigInteger(static_cast<int>(rng() >> 33));
+  }
+  return result;
+}
+
+BigInteger NaivePowmod(BigInteger base, const BigInteger& exponent, const BigInteger& modulus) {
+  std::string bits;
+  for (BigInteger rest = exponent; rest != 0; rest /= 2) {
+    bits += (rest % 2 == 0 ? '0' : '1');
+  }
+
+  BigInteger result = 1;
+  for (size_t i = bits.size(); i > 0; --i) {
+    result = result * result % modulus;
+    if (bits[i - 1] == '1') {
+      result = result * base % modulus;
+    }
+  }
+  return result;
+}
+
+template <typename Function>
+double Time(size_t repeats, Function function) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < repeats; ++i) {
+    function();
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+}
+
+int main(int argc, char** argv) {
+  size_t max_bits = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 8192);
+  std::mt19937_64 rng(42);
+
+  const int mersenne[] = {521, 1279, 2203, 4253, 9689};
+
+  std::cout << "bits\tnaive ms\tpowmod ms\todd modulus ms\tspeedup\tmodinv ms\tprime test ms\n";
+  for (size_t bits = 512, index = 0; bits <= max_bits; bits *= 2, ++index) {
+    // Even modulus: Barrett; odd modulus: Montgomery.
+    BigInteger modulus = RandomBits(bits, rng) * 2;
+    BigInteger odd = modulus + 1;
+    BigInteger base = RandomBits(bits, rng) % modulus;
+    BigInteger exponent = RandomBits(bits, rng);
+    size_t repeats = (bits <= 1024 ? 10 : bits <= 2048 ? 3 : 1);
+
+    BigInteger expected = NaivePowmod(base, exponent, odd);
+    if ((powmod(base, exponent, odd) != expected) ||
+        (powmod(base, exponent, modulus) != NaivePowmod(base, exponent, modulus))) {
+      std::cout << "MISMATCH at " << bits << " bits\n";
+      return 1;
+    }
+
+    double naive = Time(repeats, [&]() { NaivePowmod(base, exponent, odd); });
+    double barrett = Time(repeats, [&]() { powmod(base, exponent, modulus); });
+    double montgomery = Time(repeats, [&]() { powmod(base, exponent, odd); });
+    double inverse = Time(repeats, [&]() { modinv(base, odd); });
+
+    BigInteger prime = pow(BigInteger(2), mersenne[index]) - 1;
+    double test = Time(1, [&]() { is_probable_prime(prime); });
+
+    std::cout << bits << "\t" << naive << "\t" << barrett << "\t" << montgomery << "\t" << naive / montgomery << "\t"
+              << inverse << "\t" << test << " (M" << mersenne[index] << ")" << std::endl;
+  }
+}
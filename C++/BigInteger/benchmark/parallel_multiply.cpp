@@ -0,0 +1,53 @@
+// Scaling of one huge product over 1, 2, 4 and 8 threads.
+// Build: g++ -std=c++20 -O2 -pthread -I.. parallel_multiply.cpp -o parallel_multiply
+// Usage: parallel_multiply [digits] [algorithm: auto|toom|ntt]
+#include "biginteger.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+BigInteger RandomNumber(size_t digits, std::mt19937_64& rng) {
+  std::string str(digits, '0');
+  for (char& digit : str) {
+    digit = static_cast<char>('0' + rng() % 10);
+  }
+  str[0] = '1';
+  return BigInteger(str);
+}
+
+int main(int argc, char** argv) {
+  size_t digits = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000);
+  std::string name = (argc > 2 ? argv[2] : "auto");
+  BigInteger::Algorithm algorithm = BigInteger::Algorithm::Auto;
+  if (name == "toom") {
+    algorithm = BigInteger::Algorithm::ToomCook3;
+  } else if (name == "ntt") {
+    algorithm = BigInteger::Algorithm::Ntt;
+  }
+
+  std::mt19937_64 rng(2024);
+  BigInteger a = RandomNumber(digits, rng);
+  BigInteger b = RandomNumber(digits, rng);
+  std::cout << digits << " x " << digits << " digits, " << name << ", " << std::thread::hardware_concurrency()
+            << " hardware threads\n";
+
+  BigInteger reference;
+  double serial_ms = 0;
+  for (size_t threads : {1, 2, 4, 8}) {
+    BigInteger::set_parallelism(threads);
+    auto start = std::chrono::steady_clock::now();
+    BigInteger product = BigInteger::multiply(a, b, algorithm);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (threads == 1) {
+      reference = product;
+      serial_ms = ms;
+    }
+    std::cout << threads << " threads\t" << ms << " ms\tspeedup " << serial_ms / ms << "\t"
+              << (product == reference ? "ok" : "MISMATCH") << "\n";
+  }
+}
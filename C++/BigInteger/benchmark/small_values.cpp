@@ -0,0 +1,64 @@
+// Throughput of workloads dominated by values of one or two limbs.
+// Build: g++ -std=c++20 -O2 -I.. small_values.cpp -o small_values
+#include "biginteger.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+template <typename Function>
+void Run(const std::string& name, size_t operations, Function function) {
+  auto start = std::chrono::steady_clock::now();
+  std::string result = function();
+  double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  std::cout << name << "\t" << ms << " ms\t" << operations / ms / 1000 << " Mops/s\t" << result.size()
+            << " result digits\n";
+}
+
+int main(int argc, char** argv) {
+  size_t terms = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000);
+
+  // Counters and small products: every value fits in one limb.
+  Run("counter", 3000000, []() {
+    BigInteger sum;
+    for (BigInteger i = 0; i < 1000000; ++i) {
+      sum += i * 3;
+    }
+    return sum.toString();
+  });
+
+  // 1 + 1/2 + ... + 1/terms: small addends against an ever longer accumulator.
+  Run("harmonic", terms, [terms]() {
+    Rational sum;
+    for (size_t k = 1; k <= terms; ++k) {
+      sum += Rational(1) / Rational(static_cast<int>(k));
+    }
+    return sum.toString();
+  });
+
+  // Nine small values for every 60-digit one, combined at random.
+  std::vector<BigInteger> values;
+  std::vector<size_t> indices(3000000);
+  for (int i = 0; i < 1000; ++i) {
+    std::string digits = std::to_string(rand() % 1000000 + 1);
+    if (i % 10 == 0) {
+      digits = std::string(60, static_cast<char>('1' + rand() % 9));
+    }
+    values.emplace_back(digits);
+  }
+  for (size_t& index : indices) {
+    index = static_cast<size_t>(rand() % 1000);
+  }
+
+  Run("mixed", 3000000, [&values, &indices]() {
+    BigInteger sum;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+      BigInteger term = values[indices[i]] + values[indices[i + 1]];
+      sum += term * values[indices[i + 2]];
+    }
+    return sum.toString();
+  });
+}
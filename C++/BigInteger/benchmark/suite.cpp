@@ -0,0 +1,144 @@
+// Regression suite: parse, toString, add, mul, div, gcd and Rational normalize/asDecimal for
+// operands of 1 to 10^6 limbs, printed as JSON for compare.py.
+// Build: g++ -std=c++20 -O2 -I.. suite.cpp -o suite
+// Run:   ./suite [max limbs] [seconds per measurement] > current.json
+//        python3 compare.py current.json
+// Add -DBIGINTEGER_BINARY_LIMBS for 64-bit limbs. The backend is recorded in the JSON, and
+// compare.py checks against baseline_decimal.json or baseline_binary.json to match unless it
+// is given another baseline first.
+#include "biginteger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef BIGINTEGER_BINARY_LIMBS
+constexpr double kDigitsPerLimb = 64 * 0.30102999566398120;
+constexpr const char* kBackend = "binary";
+#else
+constexpr double kDigitsPerLimb = 9;
+constexpr const char* kBackend = "decimal";
+#endif
+
+// Every measurement is the fastest of kRepeats, each repeating the operation for at least the given time.
+constexpr int kRepeats = 3;
+// Euclid-like and Rational operations are quadratic; past this size one run takes minutes.
+constexpr size_t kQuadraticLimbs = 10000;
+
+size_t sink = 0;
+
+std::string RandomDigits(size_t limbs, std::mt19937_64& rng) {
+  std::string str(std::max<size_t>(1, static_cast<size_t>(static_cast<double>(limbs) * kDigitsPerLimb)), '0');
+  for (char& digit : str) {
+    digit = static_cast<char>('0' + rng() % 10);
+  }
+  str[0] = static_cast<char>('1' + rng() % 9);
+  return str;
+}
+
+struct Case {
+  std::string name;
+  size_t max_limbs;
+  // Prepares operands of the given size and returns the operation to time.
+  std::function<std::function<void()>(size_t limbs, std::mt19937_64& rng)> setup;
+};
+
+std::vector<Case> Cases() {
+  std::vector<Case> cases;
+  cases.push_back({"parse", 1000000, [](size_t limbs, std::mt19937_64& rng) {
+    return [str = RandomDigits(limbs, rng)]() {
+      BigInteger big_int;
+      BigInteger::from_chars(str.data(), str.data() + str.size(), big_int);
+      sink += static_cast<bool>(big_int);
+    };
+  }});
+  cases.push_back({"toString", 1000000, [](size_t limbs, std::mt19937_64& rng) {
+    return [big_int = BigInteger(RandomDigits(limbs, rng))]() { sink += big_int.toString().size(); };
+  }});
+  cases.push_back({"add", 1000000, [](size_t limbs, std::mt19937_64& rng) {
+    return [a = BigInteger(RandomDigits(limbs, rng)), b = BigInteger(RandomDigits(limbs, rng))]() {
+      sink += static_cast<bool>(a + b);
+    };
+  }});
+  cases.push_back({"mul", 1000000, [](size_t limbs, std::mt19937_64& rng) {
+    return [a = BigInteger(RandomDigits(limbs, rng)), b = BigInteger(RandomDigits(limbs, rng))]() {
+      sink += static_cast<bool>(a * b);
+    };
+  }});
+  // 2n limbs by n limbs, the shape that dominates toString and Rational arithmetic.
+  cases.push_back({"div", 1000000, [](size_t limbs, std::mt19937_64& rng) {
+    return [a = BigInteger(RandomDigits(2 * limbs, rng)), b = BigInteger(RandomDigits(limbs, rng))]() {
+      sink += static_cast<bool>(a / b);
+    };
+  }});
+  cases.push_back({"gcd", kQuadraticLimbs, [](size_t limbs, std::mt19937_64& rng) {
+    BigInteger common(RandomDigits(limbs / 2 + 1, rng));
+    return [a = common * BigInteger(RandomDigits(limbs / 2 + 1, rng)),
+            b = common * BigInteger(RandomDigits(limbs / 2 + 1, rng))]() { sink += static_cast<bool>(gcd(a, b)); };
+  }});
+  // A fraction whose terms share a factor of half their size, so the division has to reduce it.
+  cases.push_back({"rational_normalize", kQuadraticLimbs, [](size_t limbs, std::mt19937_64& rng) {
+    BigInteger common(RandomDigits(limbs / 2 + 1, rng));
+    return [a = Rational(common * BigInteger(RandomDigits(limbs / 2 + 1, rng))),
+            b = Rational(common * BigInteger(RandomDigits(limbs / 2 + 1, rng)))]() {
+      sink += (a / b).toString().size();
+    };
+  }});
+  // As many decimals as the terms have digits.
+  cases.push_back({"rational_asDecimal", kQuadraticLimbs, [](size_t limbs, std::mt19937_64& rng) {
+    Rational rat = Rational(BigInteger(RandomDigits(limbs, rng))) / Rational(BigInteger(RandomDigits(limbs, rng)));
+    size_t precision = static_cast<size_t>(static_cast<double>(limbs) * kDigitsPerLimb);
+    return [rat, precision]() { sink += rat.asDecimal(precision).size(); };
+  }});
+  return cases;
+}
+
+// Nanoseconds per call and the iterations of the fastest repeat.
+std::pair<double, size_t> Measure(const std::function<void()>& operation, double seconds) {
+  using Clock = std::chrono::steady_clock;
+  double best = 0;
+  size_t best_iterations = 0;
+  for (int repeat = 0; repeat < kRepeats; ++repeat) {
+    size_t iterations = 0;
+    auto start = Clock::now();
+    double elapsed = 0;
+    do {
+      operation();
+      ++iterations;
+      elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < seconds);
+
+    double ns = elapsed * 1e9 / static_cast<double>(iterations);
+    if ((repeat == 0) || (ns < best)) {
+      best = ns;
+      best_iterations = iterations;
+    }
+  }
+  return {best, best_iterations};
+}
+
+int main(int argc, char** argv) {
+  size_t max_limbs = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000);
+  double seconds = (argc > 2 ? std::strtod(argv[2], nullptr) : 0.2);
+
+  std::cout << "{\n  \"backend\": \"" << kBackend << "\",\n  \"benchmarks\": [";
+  bool first = true;
+  for (const Case& benchmark : Cases()) {
+    for (size_t limbs = 1; limbs <= std::min(max_limbs, benchmark.max_limbs); limbs *= 10) {
+      std::mt19937_64 rng(limbs);
+      auto [ns, iterations] = Measure(benchmark.setup(limbs, rng), seconds);
+      std::cout << (first ? "\n" : ",\n") << "    {\"name\": \"" << benchmark.name << "/" << limbs
+                << "\", \"limbs\": " << limbs << ", \"ns_per_op\": " << ns << ", \"iterations\": " << iterations
+                << "}";
+      std::cout.flush();
+      first = false;
+    }
+  }
+  std::cout << "\n  ],\n  \"sink\": " << sink << "\n}\n";
+}
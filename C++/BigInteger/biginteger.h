@@ -1,12 +1,392 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <random>
+#include <span>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <compare>
 
+// x86-64 builds pick the AVX2 add/sub kernels at run time when the CPU has them;
+// BIGINTEGER_NO_SIMD keeps the portable loops.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(BIGINTEGER_NO_SIMD)
+#define BIGINTEGER_X86_SIMD
+#include <immintrin.h>
+#endif
+
 class Rational;
 
-class BigInteger {
+template <typename Limbs>
+class BasicBigInteger;
+
+template <typename Limbs>
+BasicBigInteger<Limbs> gcd(const BasicBigInteger<Limbs>& big_int1, const BasicBigInteger<Limbs>& big_int2);
+template <typename Limbs>
+BasicBigInteger<Limbs> lcm(const BasicBigInteger<Limbs>& big_int1, const BasicBigInteger<Limbs>& big_int2);
+template <typename Limbs>
+std::tuple<BasicBigInteger<Limbs>, BasicBigInteger<Limbs>, BasicBigInteger<Limbs>> xgcd(
+    const BasicBigInteger<Limbs>& big_int1, const BasicBigInteger<Limbs>& big_int2);
+template <typename Limbs>
+void mul(BasicBigInteger<Limbs>& result, const BasicBigInteger<Limbs>& big_int1, const BasicBigInteger<Limbs>& big_int2);
+template <typename Limbs>
+void addmul(BasicBigInteger<Limbs>& acc, const BasicBigInteger<Limbs>& big_int1,
+            const BasicBigInteger<Limbs>& big_int2);
+template <typename Limbs>
+void submul(BasicBigInteger<Limbs>& acc, const BasicBigInteger<Limbs>& big_int1,
+            const BasicBigInteger<Limbs>& big_int2);
+
+template <typename Limbs>
+class BasicModContext;
+template <typename Limbs, size_t N>
+class BasicStaticBigInteger;
+template <typename Limbs>
+bool is_probable_prime(const BasicBigInteger<Limbs>& big_int, size_t rounds = 25);
+
+// Limbs in base 10^9: decimal text maps onto limbs directly.
+struct DecimalLimbs {
+  using Limb = uint32_t;
+  using DoubleLimb = uint64_t;
+  static constexpr DoubleLimb kBase = 1000000000;
+  static constexpr size_t kDecimalDigits = 9;
+
+  // NTT coefficients are whole limbs.
+  static constexpr uint64_t kNttBase = 1000000000;
+  static constexpr size_t kNttSplit = 1;
+  static constexpr size_t kNttThreshold = 1000;
+
+  // Values below 10^36 need no heap allocation.
+  static constexpr size_t kInlineLimbs = 4;
+};
+
+// Limbs in base 2^64: carries are plain adc chains, decimal text is converted
+// by divide and conquer only when it is printed or parsed.
+struct BinaryLimbs {
+  using Limb = uint64_t;
+  using DoubleLimb = unsigned __int128;
+  static constexpr DoubleLimb kBase = DoubleLimb(1) << 64;
+  static constexpr size_t kDecimalDigits = 0;
+
+  // Every limb is convolved as two 32-bit digits; 2^22 products of those still fit under the NTT primes.
+  static constexpr uint64_t kNttBase = uint64_t(1) << 32;
+  static constexpr size_t kNttSplit = 2;
+  static constexpr size_t kNttThreshold = 4000;
+
+  // Values below 2^128 need no heap allocation.
+  static constexpr size_t kInlineLimbs = 2;
+};
+
+// Resource that limb storage created on this thread allocates from; nullptr means
+// std::pmr::get_default_resource().
+inline std::pmr::memory_resource*& LimbResource() {
+  static thread_local std::pmr::memory_resource* resource = nullptr;
+  return resource;
+}
+
+// Memory resource over a standard allocator such as StackAllocator from C++/StackAllocator,
+// so that limbs can be put into whatever storage the allocator hands out. Requests are
+// rounded up to whole std::max_align_t blocks.
+template <typename Alloc>
+class AllocatorResource : public std::pmr::memory_resource {
+public:
+  explicit AllocatorResource(const Alloc& alloc) : alloc_(alloc) {}
+
+private:
+  using Block = std::max_align_t;
+  typename std::allocator_traits<Alloc>::template rebind_alloc<Block> alloc_;
+
+  static size_t Blocks(size_t bytes) { return (bytes + sizeof(Block) - 1) / sizeof(Block); }
+
+  void* do_allocate(size_t bytes, size_t) override { return alloc_.allocate(Blocks(bytes)); }
+  void do_deallocate(void* ptr, size_t bytes, size_t) override {
+    alloc_.deallocate(static_cast<Block*>(ptr), Blocks(bytes));
+  }
+  bool do_is_equal(const std::pmr::memory_resource& resource) const noexcept override { return this == &resource; }
+};
+
+// Vector of limbs that keeps up to N of them inline and spills to a memory resource beyond that.
+// Only the part of the std::vector interface BigInteger uses; grown limbs are zeroed by resize only.
+// As with std::pmr containers, the resource is fixed at construction (a move takes the source's)
+// and assignment between different resources copies instead of stealing the buffer.
+template <typename T, size_t N>
+class LimbStorage {
+public:
+  LimbStorage() = default;
+  explicit LimbStorage(std::pmr::memory_resource* resource) : resource_(resource) {}
+  LimbStorage(size_t size, T value) { assign(size, value); }
+  LimbStorage(const LimbStorage& storage) { assign(storage.begin(), storage.end()); }
+  LimbStorage(LimbStorage&& storage) noexcept : resource_(storage.resource_) { MoveFrom(storage); }
+
+  LimbStorage& operator=(const LimbStorage& storage) {
+    if (this != &storage) {
+      assign(storage.begin(), storage.end());
+    }
+    return *this;
+  }
+
+  LimbStorage& operator=(LimbStorage&& storage) noexcept {
+    if (this == &storage) {
+      return *this;
+    }
+    if (resource_ != storage.resource_) {
+      assign(storage.begin(), storage.end());
+      return *this;
+    }
+    Free();
+    MoveFrom(storage);
+    return *this;
+  }
+
+  ~LimbStorage() { Free(); }
+
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+  std::pmr::memory_resource* resource() const { return resource_; }
+
+  T* data() { return data_; }
+  const T* data() const { return data_; }
+  T* begin() { return data_; }
+  const T* begin() const { return data_; }
+  T* end() { return data_ + size_; }
+  const T* end() const { return data_ + size_; }
+
+  T& operator[](size_t index) { return data_[index]; }
+  const T& operator[](size_t index) const { return data_[index]; }
+  T& back() { return data_[size_ - 1]; }
+  const T& back() const { return data_[size_ - 1]; }
+
+  void reserve(size_t capacity) {
+    if (capacity > capacity_) {
+      Grow(capacity);
+    }
+  }
+
+  void resize(size_t size) {
+    if (size > capacity_) {
+      Grow(std::max(size, 2 * capacity_));
+    }
+    if (size > size_) {
+      std::fill(data_ + size_, data_ + size, T(0));
+    }
+    size_ = size;
+  }
+
+  void assign(size_t size, T value) {
+    size_ = 0;
+    reserve(size);
+    std::fill(data_, data_ + size, value);
+    size_ = size;
+  }
+
+  void assign(const T* first, const T* last) {
+    size_ = 0;
+    reserve(static_cast<size_t>(last - first));
+    std::copy(first, last, data_);
+    size_ = static_cast<size_t>(last - first);
+  }
+
+  void insert(T* position, size_t count, T value) {
+    size_t offset = static_cast<size_t>(position - data_);
+    if (size_ + count > capacity_) {
+      Grow(std::max(size_ + count, 2 * capacity_));
+    }
+    std::copy_backward(data_ + offset, data_ + size_, data_ + size_ + count);
+    std::fill(data_ + offset, data_ + offset + count, value);
+    size_ += count;
+  }
+
+  void push_back(T value) {
+    if (size_ == capacity_) {
+      Grow(2 * capacity_);
+    }
+    data_[size_++] = value;
+  }
+
+  void emplace_back(T value) { push_back(value); }
+  void pop_back() { --size_; }
+  void clear() { size_ = 0; }
+
+private:
+  T* data_ = inline_;
+  size_t size_ = 0;
+  size_t capacity_ = N;
+  std::pmr::memory_resource* resource_ =
+      (LimbResource() != nullptr ? LimbResource() : std::pmr::get_default_resource());
+  T inline_[N];
+
+  void Grow(size_t capacity) {
+    T* data = static_cast<T*>(resource_->allocate(capacity * sizeof(T), alignof(T)));
+    std::copy(data_, data_ + size_, data);
+    Free();
+    data_ = data;
+    capacity_ = capacity;
+  }
+
+  void Free() {
+    if (data_ != inline_) {
+      resource_->deallocate(data_, capacity_ * sizeof(T), alignof(T));
+    }
+  }
+
+  void MoveFrom(LimbStorage& storage) {
+    if (storage.data_ == storage.inline_) {
+      std::copy(storage.inline_, storage.inline_ + storage.size_, inline_);
+      data_ = inline_;
+      capacity_ = N;
+    } else {
+      data_ = storage.data_;
+      capacity_ = storage.capacity_;
+      storage.data_ = storage.inline_;
+      storage.capacity_ = N;
+    }
+    size_ = storage.size_;
+    storage.size_ = 0;
+  }
+};
+
+// Fixed set of worker threads for splitting large multiplications. ParallelFor runs
+// tasks on the calling thread as well, so a task may start a nested ParallelFor
+// without waiting on workers that are all busy.
+class ThreadPool {
+public:
+  explicit ThreadPool(size_t workers);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  size_t size() const { return workers_.size() + 1; }
+
+  // Calls body(i) for every i in [0, count) and returns once all calls have finished.
+  template <typename Body>
+  void ParallelFor(size_t count, const Body& body);
+
+private:
+  void Work();
+
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  bool stop_ = false;
+};
+
+inline ThreadPool::ThreadPool(size_t workers) {
+  workers_.reserve(workers);
+  for (size_t i = 0; i < workers; ++i) {
+    workers_.emplace_back([this] { Work(); });
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  ready_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+inline void ThreadPool::Work() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      ready_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+// Every participant pulls indices from a shared counter; a helper that starts after
+// the indices ran out returns without touching body.
+template <typename Body>
+void ThreadPool::ParallelFor(size_t count, const Body& body) {
+  struct State {
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+  };
+
+  auto state = std::make_shared<State>();
+  auto run = [state, count, &body] {
+    for (size_t i = state->next++; i < count; i = state->next++) {
+      body(i);
+      if (++state->done == count) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->finished.notify_all();
+      }
+    }
+  };
+
+  size_t helpers = std::min(count, workers_.size() + 1) - 1;
+  if (helpers > 0) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (size_t i = 0; i < helpers; ++i) {
+        tasks_.emplace_back(run);
+      }
+    }
+    ready_.notify_all();
+  }
+
+  run();
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->finished.wait(lock, [&] { return state->done == count; });
+}
+
+template <typename Limbs>
+class BasicBigInteger {
   friend Rational;
+  friend BasicBigInteger gcd<>(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2);
+  friend BasicBigInteger lcm<>(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2);
+  friend std::tuple<BasicBigInteger, BasicBigInteger, BasicBigInteger> xgcd<>(const BasicBigInteger& big_int1,
+                                                                            const BasicBigInteger& big_int2);
+  friend void mul<>(BasicBigInteger& result, const BasicBigInteger& big_int1, const BasicBigInteger& big_int2);
+  friend void addmul<>(BasicBigInteger& acc, const BasicBigInteger& big_int1, const BasicBigInteger& big_int2);
+  friend void submul<>(BasicBigInteger& acc, const BasicBigInteger& big_int1, const BasicBigInteger& big_int2);
+  template <typename>
+  friend class BasicBigInteger;
+  friend class BasicModContext<Limbs>;
+  template <typename, size_t>
+  friend class BasicStaticBigInteger;
+public:
+  using Backend = Limbs;
+  using Limb = typename Limbs::Limb;
+  using DoubleLimb = typename Limbs::DoubleLimb;
+  using Storage = LimbStorage<Limb, Limbs::kInlineLimbs>;
+
+  enum class Algorithm {
+    Auto,
+    Schoolbook,
+    Karatsuba,
+    ToomCook3,
+    Ntt
+  };
+
 private:
   enum Sign : int {
     Positive = 1,
@@ -14,651 +394,3488 @@ private:
     Zero = 0
   } sign_;
 
-  std::vector<uint32_t> number_;
-  const uint32_t kRang = 1000000000;
+  Storage number_;
+  static constexpr DoubleLimb kRang = Limbs::kBase;
+
+  // Limb counts of the smaller operand at which Multi switches to the next tier.
+  static constexpr size_t kKaratsubaThreshold = 40;
+  static constexpr size_t kToomCook3Threshold = 700;
+  static constexpr size_t kNttThreshold = Limbs::kNttThreshold;
+
+  // NTT primes p = c * 2^k + 1 with primitive root 3; the product of all three
+  // bounds a convolution coefficient of up to 2^23 products of two 10^9 digits.
+  static constexpr uint32_t kNttMod1 = 998244353;
+  static constexpr uint32_t kNttMod2 = 167772161;
+  static constexpr uint32_t kNttMod3 = 469762049;
+  static constexpr size_t kNttMaxLength = size_t(1) << 23;
+
+  // Default smaller-operand limb count from which a product is split across the pool,
+  // and the number of pieces each parallel NTT pass is cut into.
+  static constexpr size_t kParallelThreshold = 20000;
+  static constexpr size_t kParallelChunks = 64;
+
+  // Divisor and quotient limb counts from which Burnikel-Ziegler replaces Knuth's algorithm D.
+  static constexpr size_t kBurnikelZieglerThreshold = 60;
+
+  // Limb counts below which radix conversion of binary limbs stays quadratic.
+  static constexpr size_t kRadixConversionThreshold = 30;
+  static constexpr uint64_t kDecimalChunk = 10000000000000000000ULL;
+  static constexpr size_t kDecimalChunkDigits = 19;
 
   void DecToOur(uint32_t value);
-  BigInteger Abs(const BigInteger& big_int) const;
-  BigInteger PositivePlusPositive(const BigInteger& big_int) const;
-  BigInteger PositivePlusNegative(const BigInteger& big_int1, const BigInteger& big_int2) const;
-  BigInteger Multi(const BigInteger& big_int1, const BigInteger& big_int2) const;
-  BigInteger Division(const BigInteger& big_int1, const BigInteger& big_int2) const;
-  void Swap(BigInteger& big_int);
+  static BasicBigInteger FromWord(uint64_t value);
+  static uint64_t ToWord(const BasicBigInteger& big_int);
+  static BasicBigInteger PowerOfTwo(size_t exponent);
+  // |big_int| as little-endian 64-bit words, and back.
+  static std::vector<uint64_t> BinaryWords(const BasicBigInteger& big_int);
+  static BasicBigInteger FromBinaryWords(const uint64_t* words, size_t count);
+  // Applies op word by word to the two's-complement forms of both arguments.
+  template <typename Op>
+  static BasicBigInteger Bitwise(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2, Op op);
+  static double ApproxBitLength(const BasicBigInteger& big_int);
+  static BasicBigInteger Abs(const BasicBigInteger& big_int);
+  // Drops leading zero limbs but the last; sign applies unless the magnitude is zero.
+  void Normalize(Sign sign);
+  // Tests the magnitude, so that it holds whatever sign_ says.
+  bool IsZero() const { return number_.back() == 0; }
+  void AddInPlace(const BasicBigInteger& big_int, Sign sign);
+  void AddInPlace(const Limb* data, size_t size, Sign sign);
+  void AddMulInPlace(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2, Sign sign);
+  static void MulInto(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2, BasicBigInteger& result);
+  static BasicBigInteger Multi(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2,
+                               Algorithm algorithm = Algorithm::Auto);
+  void Swap(BasicBigInteger& big_int);
+
+  static BasicBigInteger FromLimbs(const Limb* data, size_t size);
+  static void ShiftLimbs(BasicBigInteger& big_int, size_t count);
+  static Limb DivSmall(BasicBigInteger& big_int, Limb value);
+  static void MulSmall(BasicBigInteger& big_int, Limb value);
+  static void AddSmall(BasicBigInteger& big_int, Limb value);
+  static int CompareAbs(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2);
+  static constexpr int CompareLimbs(const Limb* a, size_t n, const Limb* b, size_t m);
+  static BasicBigInteger HighLimbs(const BasicBigInteger& big_int, size_t count);
+  static BasicBigInteger LowLimbs(const BasicBigInteger& big_int, size_t count);
+
+  // The limb kernels are constexpr so that BasicStaticBigInteger can share them.
+  static constexpr size_t AddLimbs(const Limb* a, size_t n, const Limb* b, size_t m, Limb* out);
+  static constexpr void AddLimbsInPlace(Limb* a, size_t n, const Limb* b, size_t m);
+  static constexpr void SubLimbsInPlace(Limb* a, size_t n, const Limb* b, size_t m);
+  static void ReverseSubLimbsInPlace(Limb* a, const Limb* b, size_t n);
+
+  // out[0, n) = a + b + carry and a - b - borrow over equal lengths, returning the carry
+  // or borrow out; out may be a or b. Every add/sub path above ends up here.
+  static constexpr Limb AddCarry(const Limb* a, const Limb* b, Limb* out, size_t n, Limb carry);
+  static constexpr Limb SubBorrow(const Limb* a, const Limb* b, Limb* out, size_t n, Limb borrow);
+#ifdef BIGINTEGER_X86_SIMD
+  static bool HasAvx2();
+  __attribute__((target("avx2"))) static Limb AddCarryAvx2(const Limb* a, const Limb* b, Limb* out, size_t n,
+                                                           Limb carry);
+  __attribute__((target("avx2"))) static Limb SubBorrowAvx2(const Limb* a, const Limb* b, Limb* out, size_t n,
+                                                            Limb borrow);
+#endif
+
+  // Stack of limb blocks for kernel temporaries. Blocks are never moved or freed,
+  // so once they have grown to the working size the kernels stop touching the heap.
+  class Scratch {
+  public:
+    struct Mark {
+      size_t block;
+      size_t used;
+    };
+
+    Mark Position() const { return {block_, used_}; }
+    void Release(Mark mark) {
+      block_ = mark.block;
+      used_ = mark.used;
+    }
+    Limb* Take(size_t size);
+
+  private:
+    std::vector<std::unique_ptr<Limb[]>> blocks_;
+    std::vector<size_t> sizes_;
+    size_t block_ = 0;
+    size_t used_ = 0;
+  };
+
+  static Scratch& ScratchSpace();
+  explicit BasicBigInteger(Storage&& buffer) : sign_(Zero), number_(std::move(buffer)) {}
+  // Limb buffer handed from consumed temporaries to the next product.
+  static Storage& SpareLimbs();
+  static void Recycle(BasicBigInteger& big_int);
+
+  static std::unique_ptr<ThreadPool>& Pool();
+  static size_t& ParallelThreshold();
+  static bool Parallel(size_t limbs) { return Pool() && (limbs >= ParallelThreshold()); }
+  // Runs body(i) for i in [0, count), on the pool when parallel is set.
+  template <typename Body>
+  static void ForEach(size_t count, bool parallel, const Body& body);
+
+  static void MulLimbs(const Limb* a, size_t n, const Limb* b, size_t m, Limb* out, Algorithm algorithm);
+  static constexpr void MulSchoolbook(const Limb* a, size_t n, const Limb* b, size_t m, Limb* out);
+  static void MulUnbalanced(const Limb* a, size_t n, const Limb* b, size_t m, Limb* out, Algorithm algorithm);
+  static void MulKaratsuba(const Limb* a, size_t n, const Limb* b, size_t m, Limb* out, Algorithm algorithm);
+  static void MulToomCook3(const Limb* a, size_t n, const Limb* b, size_t m, Limb* out, Algorithm algorithm);
+  static void MulNtt(const Limb* a, size_t n, const Limb* b, size_t m, Limb* out);
+
+  // multiply_batch takes pairs of up to kBatchLimbs decimal limbs kBatchLanes at a time, with their
+  // limbs interleaved so that one vector multiply serves the same limb position of every pair.
+  // Column sums are folded into 32-bit halves every kBatchFold products, before 64 bits overflow.
+  static constexpr size_t kBatchLanes = 4;
+  static constexpr size_t kBatchLimbs = kKaratsubaThreshold;
+  static constexpr size_t kBatchFold = 16;
+  // Work items for the pool: a group of up to kBatchLanes pairs or one pair on its own.
+  static void MulBatchGroup(const size_t* indices, size_t lanes, std::span<const BasicBigInteger> big_ints1,
+                            std::span<const BasicBigInteger> big_ints2, std::span<BasicBigInteger> result,
+                            std::vector<uint64_t>& packed);
+  // a: n rows, b: m rows, out: n + m rows of kBatchLanes interleaved limbs, one product per lane.
+  static void MulBatchLanes(const uint64_t* a, size_t n, const uint64_t* b, size_t m, uint64_t* out);
+  static void FoldBatchColumn(const uint64_t* low, const uint64_t* high, uint64_t* carry, uint64_t* out);
+#ifdef BIGINTEGER_X86_SIMD
+  __attribute__((target("avx2"))) static void MulBatchLanesAvx2(const uint64_t* a, size_t n, const uint64_t* b,
+                                                                size_t m, uint64_t* out);
+#endif
+  // Splits [0, count) into ranges for body(begin, end), over the pool when work limbs reach the threshold.
+  template <typename Body>
+  static void ForEachRange(size_t count, size_t work, const Body& body);
+
+  static constexpr uint32_t PowMod(uint32_t base, uint64_t exp, uint32_t mod);
+  template <uint32_t kMod>
+  static void Ntt(std::vector<uint32_t>& values, bool invert, bool parallel);
+
+  // work holds n + m + 1 limbs.
+  static constexpr void DivKnuth(const Limb* a, size_t n, const Limb* b, size_t m, Limb* quotient,
+                                 Limb* remainder, Limb* work);
+  static void DivModAbs(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2, BasicBigInteger& quotient,
+                        BasicBigInteger& remainder);
+  static void DivModKnuth(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2, BasicBigInteger& quotient,
+                          BasicBigInteger& remainder);
+  static void DivBurnikelZiegler(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2,
+                                 BasicBigInteger& quotient, BasicBigInteger& remainder);
+  static void Div2n1n(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2, size_t n,
+                      BasicBigInteger& quotient, BasicBigInteger& remainder);
+  static void Div3n2n(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2, size_t half,
+                      BasicBigInteger& quotient, BasicBigInteger& remainder);
+
+  static void LeadingWords(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2, uint64_t& word1,
+                           uint64_t& word2);
+  static void LehmerStep(BasicBigInteger& big_int1, BasicBigInteger& big_int2, int64_t a, int64_t b, int64_t c,
+                         int64_t d);
+  static BasicBigInteger GcdLehmer(BasicBigInteger big_int1, BasicBigInteger big_int2, BasicBigInteger* cofactor);
+
+  static const std::vector<BasicBigInteger>& DecimalPowers(size_t count);
+  static void ToDecimalChunks(const BasicBigInteger& big_int, const std::vector<BasicBigInteger>& powers,
+                              size_t level, uint64_t* chunks);
+  static BasicBigInteger FromDecimalChunks(const uint64_t* chunks, size_t count,
+                                           const std::vector<BasicBigInteger>& powers);
+  template <typename Chunk>
+  static void ReadChunks(const char* first, const char* last, size_t width, Chunk* chunks);
+  template <typename Chunk>
+  static std::to_chars_result WriteChunks(char* first, char* last, bool negative, const Chunk* chunks, size_t count,
+                                          size_t width);
 
 public:
-  BigInteger() : sign_(Zero), number_(1, 0) {}
-  BigInteger(int value);
-  BigInteger(const std::string& str);
-  BigInteger(const BigInteger& big_int);
+  BasicBigInteger() : sign_(Zero), number_(1, 0) {}
+  BasicBigInteger(int value);
+  BasicBigInteger(std::string_view str);
+  BasicBigInteger(const BasicBigInteger& big_int);
 
-  BigInteger(BigInteger&& big_int) : sign_(big_int.sign_), number_(std::move(big_int.number_)) {
+  BasicBigInteger(BasicBigInteger&& big_int) : sign_(big_int.sign_), number_(std::move(big_int.number_)) {
     big_int.sign_ = Zero;
   }
 
-  BigInteger& operator=(BigInteger&& big_int) {
+  BasicBigInteger& operator=(BasicBigInteger big_int);
 
-  }
-
-  BigInteger& operator=(BigInteger big_int);
-
-  ~BigInteger() = default;
+  ~BasicBigInteger() = default;
 
   explicit operator bool() const;
   std::string toString(void) const;
 
-  bool operator<(const BigInteger& big_int) const;
-  bool operator>(const BigInteger& big_int) const { return big_int < *this; }
-  bool operator<=(const BigInteger& big_int) const { return !(*this > big_int); }
-  bool operator>=(const BigInteger& big_int) const { return !(*this < big_int); }
-  bool operator==(const BigInteger& big_int) const;
-  bool operator!=(const BigInteger& big_int) const { return !(*this == big_int); }
-
-  BigInteger operator-() const;
-
-  BigInteger& operator+=(const BigInteger& big_int);
-  BigInteger operator+(const BigInteger& big_int) const;
-  BigInteger& operator-=(const BigInteger& big_int);
-  BigInteger operator-(const BigInteger& big_int) const;
-  BigInteger& operator*=(const BigInteger& big_int);
-  BigInteger operator*(const BigInteger& big_int) const;
-  BigInteger& operator/=(const BigInteger& big_int);
-  BigInteger operator/(const BigInteger& big_int) const;
-  BigInteger& operator%=(const BigInteger& big_int);
-  BigInteger operator%(const BigInteger& big_int) const;
-
-  BigInteger& operator++();
-  BigInteger& operator--();
-  BigInteger operator++(int);
-  BigInteger operator--(int);
+  bool operator<(const BasicBigInteger& big_int) const;
+  bool operator>(const BasicBigInteger& big_int) const { return big_int < *this; }
+  bool operator<=(const BasicBigInteger& big_int) const { return !(*this > big_int); }
+  bool operator>=(const BasicBigInteger& big_int) const { return !(*this < big_int); }
+  bool operator==(const BasicBigInteger& big_int) const;
+  bool operator!=(const BasicBigInteger& big_int) const { return !(*this == big_int); }
+
+  BasicBigInteger operator-() const;
+
+  BasicBigInteger& operator+=(const BasicBigInteger& big_int);
+  BasicBigInteger& operator+=(BasicBigInteger&& big_int);
+  BasicBigInteger operator+(const BasicBigInteger& big_int) const;
+  BasicBigInteger& operator-=(const BasicBigInteger& big_int);
+  BasicBigInteger& operator-=(BasicBigInteger&& big_int);
+  BasicBigInteger operator-(const BasicBigInteger& big_int) const;
+  BasicBigInteger& operator*=(const BasicBigInteger& big_int);
+  BasicBigInteger operator*(const BasicBigInteger& big_int) const;
+  BasicBigInteger& operator/=(const BasicBigInteger& big_int);
+  BasicBigInteger operator/(const BasicBigInteger& big_int) const;
+  BasicBigInteger& operator%=(const BasicBigInteger& big_int);
+  BasicBigInteger operator%(const BasicBigInteger& big_int) const;
+
+  BasicBigInteger& operator++();
+  BasicBigInteger& operator--();
+  BasicBigInteger operator++(int);
+  BasicBigInteger operator--(int);
+
+  // Bitwise operators act on the infinite two's-complement form, as in GMP,
+  // so x >> k rounds towards minus infinity and ~x == -x - 1.
+  BasicBigInteger operator~() const;
+  BasicBigInteger& operator&=(const BasicBigInteger& big_int);
+  BasicBigInteger operator&(const BasicBigInteger& big_int) const;
+  BasicBigInteger& operator|=(const BasicBigInteger& big_int);
+  BasicBigInteger operator|(const BasicBigInteger& big_int) const;
+  BasicBigInteger& operator^=(const BasicBigInteger& big_int);
+  BasicBigInteger operator^(const BasicBigInteger& big_int) const;
+  BasicBigInteger& operator<<=(size_t shift);
+  BasicBigInteger operator<<(size_t shift) const;
+  BasicBigInteger& operator>>=(size_t shift);
+  BasicBigInteger operator>>(size_t shift) const;
+
+  // Bits of |x|, zero for zero.
+  size_t bit_length() const;
+  // Bit `index` of the two's-complement form.
+  bool test_bit(size_t index) const;
+  // One bits of a non-negative value; the maximum size_t for negative ones, as in GMP.
+  size_t popcount() const;
+
+  static BasicBigInteger multiply(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2,
+                                  Algorithm algorithm = Algorithm::Auto);
+  // Truncating division: the quotient is rounded towards zero, the remainder takes the dividend's sign.
+  static std::pair<BasicBigInteger, BasicBigInteger> divmod(const BasicBigInteger& big_int1,
+                                                            const BasicBigInteger& big_int2);
+
+  // result[i] = big_ints1[i] * big_ints2[i] and so on for i below the shortest span's size. result[i]
+  // may be big_ints1[i] or big_ints2[i], but no other input. Batches are split over the pool set by
+  // set_parallelism once their total limb count reaches its threshold.
+  static void multiply_batch(std::span<const BasicBigInteger> big_ints1, std::span<const BasicBigInteger> big_ints2,
+                             std::span<BasicBigInteger> result);
+  static void add_batch(std::span<const BasicBigInteger> big_ints1, std::span<const BasicBigInteger> big_ints2,
+                        std::span<BasicBigInteger> result);
+  // bases[i]^exponents[i] mod modulus through one shared BasicModContext; modulus must be positive.
+  static void powmod_batch(std::span<const BasicBigInteger> bases, std::span<const BasicBigInteger> exponents,
+                           const BasicBigInteger& modulus, std::span<BasicBigInteger> result);
+
+  // Same contract as std::from_chars: an optional '-' and decimal digits, ptr stops at the first non-digit.
+  static std::from_chars_result from_chars(const char* first, const char* last, BasicBigInteger& big_int);
+  // Same contract as std::to_chars; a buffer of max_chars(big_int) characters is always enough.
+  static std::to_chars_result to_chars(char* first, char* last, const BasicBigInteger& big_int);
+  static size_t max_chars(const BasicBigInteger& big_int);
+
+  // Products whose smaller operand has at least threshold limbs are spread over
+  // threads workers (the calling thread included); threads <= 1 keeps everything serial.
+  // Not safe to call while another thread is multiplying.
+  static void set_parallelism(size_t threads, size_t threshold = kParallelThreshold);
+  static size_t parallelism();
+
+  // Limbs beyond the inline ones of numbers created on this thread from now on are taken
+  // from resource (nullptr: std::pmr::get_default_resource()); returns the previous one.
+  // A number keeps its resource for life and is moved or returned along with it, but
+  // assigning into a number made elsewhere copies, so that a monotonic arena or a
+  // StackStorage behind AllocatorResource can be dropped once its results are assigned out.
+  static std::pmr::memory_resource* set_memory_resource(std::pmr::memory_resource* resource);
+  static std::pmr::memory_resource* memory_resource();
+};
+
+#ifdef BIGINTEGER_BINARY_LIMBS
+using BigInteger = BasicBigInteger<BinaryLimbs>;
+#else
+using BigInteger = BasicBigInteger<DecimalLimbs>;
+#endif
+
+// Value of at most N limbs with its limbs in place, whose arithmetic runs in constant
+// expressions on the same kernels as BasicBigInteger. Meant for constants folded at compile
+// time: moduli, tables, _bi literals. Results are sized to hold any value (a + b gets
+// max(N, M) + 1 limbs, a * b gets N + M), and conversion to BasicBigInteger copies the limbs.
+// Anything that does not fit, and division by zero, fails to compile in a constant
+// expression and gives zero at run time.
+template <typename Limbs, size_t N>
+class BasicStaticBigInteger {
+  template <typename, size_t>
+  friend class BasicStaticBigInteger;
+  using BigInt = BasicBigInteger<Limbs>;
+
+public:
+  using Limb = typename Limbs::Limb;
+  using DoubleLimb = typename Limbs::DoubleLimb;
+
+  constexpr BasicStaticBigInteger() = default;
+  constexpr BasicStaticBigInteger(int value);
+  // Decimal digits, or hexadecimal ones after 0x, with an optional '-' and ' separators.
+  constexpr explicit BasicStaticBigInteger(std::string_view str);
+  template <size_t M>
+  constexpr explicit(M > N) BasicStaticBigInteger(const BasicStaticBigInteger<Limbs, M>& value);
+
+  operator BasicBigInteger<Limbs>() const;
+  constexpr explicit operator bool() const { return sign_ != 0; }
+
+  template <size_t M>
+  constexpr bool operator==(const BasicStaticBigInteger<Limbs, M>& value) const;
+  template <size_t M>
+  constexpr std::strong_ordering operator<=>(const BasicStaticBigInteger<Limbs, M>& value) const;
+
+  constexpr BasicStaticBigInteger operator-() const;
+  template <size_t M>
+  constexpr auto operator+(const BasicStaticBigInteger<Limbs, M>& value) const;
+  template <size_t M>
+  constexpr auto operator-(const BasicStaticBigInteger<Limbs, M>& value) const;
+  template <size_t M>
+  constexpr BasicStaticBigInteger<Limbs, N + M> operator*(const BasicStaticBigInteger<Limbs, M>& value) const;
+  // Truncating, as BasicBigInteger::divmod.
+  template <size_t M>
+  constexpr BasicStaticBigInteger operator/(const BasicStaticBigInteger<Limbs, M>& value) const;
+  template <size_t M>
+  constexpr BasicStaticBigInteger<Limbs, M> operator%(const BasicStaticBigInteger<Limbs, M>& value) const;
+
+private:
+  Limb limbs_[N]{};
+  size_t size_ = 0;
+  int sign_ = 0;
+
+  static constexpr DoubleLimb kRang = Limbs::kBase;
+
+  // Not constexpr: reaching it stops constant evaluation.
+  static void NotRepresentable() {}
+
+  constexpr void Normalize(int sign);
+  constexpr void MulAdd(Limb factor, Limb addend);
+  template <size_t A, size_t B>
+  constexpr void Combine(const BasicStaticBigInteger<Limbs, A>& big_int1, const BasicStaticBigInteger<Limbs, B>& big_int2,
+                         int sign);
+  template <size_t M>
+  static constexpr void DivMod(const BasicStaticBigInteger& big_int1, const BasicStaticBigInteger<Limbs, M>& big_int2,
+                               BasicStaticBigInteger& quotient, BasicStaticBigInteger<Limbs, M>& remainder);
 };
 
-void BigInteger::DecToOur(uint32_t value) {
+template <size_t N>
+using StaticBigInteger = BasicStaticBigInteger<BigInteger::Backend, N>;
+
+// Limbs enough for an integer literal of the given length: no character adds four bits.
+template <typename Limbs>
+constexpr size_t LiteralLimbs(size_t chars) {
+  if constexpr (Limbs::kDecimalDigits == 0) {
+    return chars * 4 / 64 + 1;
+  } else {
+    return (chars * 121 / 100 + 1) / 9 + 1;
+  }
+}
+
+template <typename Limbs>
+void BasicBigInteger<Limbs>::DecToOur(uint32_t value) {
   number_.clear();
   while (value > 0) {
-    number_.emplace_back(value % kRang);
-    value /= kRang;
+    number_.emplace_back(static_cast<Limb>(value % kRang));
+    value = static_cast<uint32_t>(value / kRang);
   }
 }
 
-BigInteger BigInteger::Abs(const BigInteger& big_int) const {
-  BigInteger new_big_int = big_int;
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::Abs(const BasicBigInteger& big_int) {
+  BasicBigInteger new_big_int = big_int;
 
   if (new_big_int.sign_ == Negative) {
     new_big_int.sign_ = Positive;
   }
 
-  return std::move(new_big_int);
+  return new_big_int;
 }
 
-BigInteger BigInteger::PositivePlusPositive(const BigInteger& big_int) const {
-  uint32_t old_tmp = 0;
-  BigInteger new_big_int;
-  new_big_int.sign_ = Positive;
-  new_big_int.number_.clear();
+template <typename Limbs>
+void BasicBigInteger<Limbs>::Normalize(Sign sign) {
+  while ((number_.size() > 1) && (number_.back() == 0)) {
+    number_.pop_back();
+  }
+  sign_ = (number_.back() == 0 ? Zero : sign);
+}
 
-  if (big_int.number_.size() > number_.size()) {
-    for (size_t i = 0; i < number_.size(); ++i) {
-      uint32_t value = big_int.number_[i] + number_[i] + old_tmp;
-      if (value >= kRang) {
-        old_tmp = 1;
-      } else {
-        old_tmp = 0;
-      }
-      new_big_int.number_.emplace_back(value % kRang);
-    }
+// *this += big_int taken with the given sign. Works in number_ and only grows it when the sum needs more limbs.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::AddInPlace(const BasicBigInteger& big_int, Sign sign) {
+  AddInPlace(big_int.number_.data(), big_int.number_.size(), sign);
+}
 
-    for (size_t i = number_.size(); i < big_int.number_.size(); ++i) {
-      uint32_t value = big_int.number_[i] + old_tmp;
-      if (value >= kRang) {
-        old_tmp = 1;
-      } else {
-        old_tmp = 0;
-      }
-      new_big_int.number_.emplace_back(value % kRang);
-    }
+// Adds the magnitude in data[0, size), taken with the given sign. data may point into number_.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::AddInPlace(const Limb* data, size_t size, Sign sign) {
+  if (sign == Zero) {
+    return;
+  }
+  if (sign_ == Zero) {
+    number_.assign(data, data + size);
+    sign_ = sign;
+    return;
+  }
 
-    if (old_tmp) {
-      new_big_int.number_.emplace_back(old_tmp);
-    }
-  } else if (big_int.number_.size() < number_.size()) {
-    for (size_t i = 0; i < big_int.number_.size(); ++i) {
-      uint32_t value = big_int.number_[i] + number_[i] + old_tmp;
-      if (value >= kRang) {
-        old_tmp = 1;
-      } else {
-        old_tmp = 0;
-      }
-      new_big_int.number_.emplace_back(value % kRang);
-    }
+  bool self = (data == number_.data());
+  size_t n = number_.size();
 
-    for (size_t i = big_int.number_.size(); i < number_.size(); ++i) {
-      uint32_t value = number_[i] + old_tmp;
-      if (value >= kRang) {
-        old_tmp = 1;
-      } else {
-        old_tmp = 0;
-      }
-      new_big_int.number_.emplace_back(value % kRang);
-    }
+  if (sign_ == sign) {
+    number_.resize(std::max(n, size) + 1);
+    data = (self ? number_.data() : data);
+    number_.resize(AddLimbs(number_.data(), n, data, size, number_.data()));
+    return;
+  }
 
-    if (old_tmp) {
-      new_big_int.number_.emplace_back(old_tmp);
-    }
+  int cmp = CompareLimbs(number_.data(), n, data, size);
+  if (cmp == 0) {
+    number_.assign(1, 0);
+    sign_ = Zero;
+    return;
+  }
+
+  if (cmp > 0) {
+    SubLimbsInPlace(number_.data(), n, data, size);
   } else {
-    for (size_t i = 0; i < number_.size(); ++i) {
-      uint32_t value = big_int.number_[i] + number_[i] + old_tmp;
-      if (value >= kRang) {
-        old_tmp = 1;
-      } else {
-        old_tmp = 0;
-      }
-      new_big_int.number_.emplace_back(value % kRang);
-    }
+    number_.resize(size);
+    ReverseSubLimbsInPlace(number_.data(), data, size);
+    sign_ = sign;
+  }
 
-    if (old_tmp) {
-      new_big_int.number_.emplace_back(old_tmp);
-    }
+  Normalize(sign_);
+}
+
+// *this += sign * big_int1 * big_int2 through a scratch product; any argument may alias *this.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::AddMulInPlace(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2,
+                                           Sign sign) {
+  if (big_int1.IsZero() || big_int2.IsZero() || (sign == Zero)) {
+    return;
+  }
+
+  size_t n = big_int1.number_.size();
+  size_t m = big_int2.number_.size();
+  Scratch& scratch = ScratchSpace();
+  auto mark = scratch.Position();
+  Limb* out = scratch.Take(n + m);
+  MulLimbs(big_int1.number_.data(), n, big_int2.number_.data(), m, out, Algorithm::Auto);
+
+  size_t size = n + m;
+  while ((size > 1) && (out[size - 1] == 0)) {
+    --size;
+  }
+  AddInPlace(out, size, static_cast<Sign>(sign * big_int1.sign_ * big_int2.sign_));
+  scratch.Release(mark);
+}
+
+// result = big_int1 * big_int2; result may be one of the operands.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::MulInto(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2,
+                                     BasicBigInteger& result) {
+  if (big_int1.IsZero() || big_int2.IsZero()) {
+    result.number_.assign(1, 0);
+    result.sign_ = Zero;
+    return;
+  }
+
+  Sign sign = (big_int1.sign_ == big_int2.sign_ ? Positive : Negative);
+  size_t n = big_int1.number_.size();
+  size_t m = big_int2.number_.size();
+
+  if ((&result != &big_int1) && (&result != &big_int2)) {
+    result.number_.resize(n + m);
+    MulLimbs(big_int1.number_.data(), n, big_int2.number_.data(), m, result.number_.data(), Algorithm::Auto);
+  } else {
+    Scratch& scratch = ScratchSpace();
+    auto mark = scratch.Position();
+    Limb* out = scratch.Take(n + m);
+    MulLimbs(big_int1.number_.data(), n, big_int2.number_.data(), m, out, Algorithm::Auto);
+    result.number_.assign(out, out + n + m);
+    scratch.Release(mark);
   }
 
-  return std::move(new_big_int);
+  result.Normalize(sign);
 }
 
-BigInteger BigInteger::PositivePlusNegative(const BigInteger& big_int1, const BigInteger& big_int2) const {
-  uint32_t old_tmp = 0;
-  BigInteger new_big_int;
-  new_big_int.number_.clear();
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::Multi(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2,
+                                                     Algorithm algorithm) {
+  BasicBigInteger new_big_int;
+  new_big_int.number_.resize(big_int1.number_.size() + big_int2.number_.size());
 
-  if (big_int1.number_.size() > big_int2.number_.size()) {
-    new_big_int.sign_ = Positive;
+  MulLimbs(big_int1.number_.data(), big_int1.number_.size(), big_int2.number_.data(), big_int2.number_.size(),
+           new_big_int.number_.data(), algorithm);
 
-    for (size_t i = 0; i < big_int2.number_.size(); ++i) {
-      if (big_int1.number_[i] != 0) {
-        if (big_int1.number_[i] - old_tmp < big_int2.number_[i]) {
-          new_big_int.number_.emplace_back(kRang + big_int1.number_[i] - old_tmp - big_int2.number_[i]);
-          old_tmp = 1;
-        } else {
-          new_big_int.number_.emplace_back(big_int1.number_[i] - old_tmp - big_int2.number_[i]);
-          old_tmp = 0;
-        }
-      } else {
-        if ((old_tmp != 0) || (big_int2.number_[i] != 0)) {
-          new_big_int.number_.emplace_back(kRang - old_tmp - big_int2.number_[i]);
-          old_tmp = 1;
-        } else {
-          new_big_int.number_.emplace_back(0);
-          old_tmp = 0;
-        }
-      }
+  new_big_int.Normalize(Positive);
+
+  return new_big_int;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::FromLimbs(const Limb* data, size_t size) {
+  while ((size > 0) && (data[size - 1] == 0)) {
+    --size;
+  }
+
+  BasicBigInteger big_int;
+  if (size != 0) {
+    big_int.sign_ = Positive;
+    big_int.number_.assign(data, data + size);
+  }
+
+  return big_int;
+}
+
+template <typename Limbs>
+void BasicBigInteger<Limbs>::ShiftLimbs(BasicBigInteger& big_int, size_t count) {
+  if ((big_int.sign_ != Zero) && (count != 0)) {
+    big_int.number_.insert(big_int.number_.begin(), count, 0);
+  }
+}
+
+template <typename Limbs>
+typename Limbs::Limb BasicBigInteger<Limbs>::DivSmall(BasicBigInteger& big_int, Limb value) {
+  DoubleLimb rest = 0;
+
+  for (size_t i = big_int.number_.size(); i > 0; --i) {
+    DoubleLimb cur = rest * kRang + big_int.number_[i - 1];
+    big_int.number_[i - 1] = static_cast<Limb>(cur / value);
+    rest = cur % value;
+  }
+
+  big_int.Normalize(big_int.sign_);
+  return static_cast<Limb>(rest);
+}
+
+template <typename Limbs>
+void BasicBigInteger<Limbs>::MulSmall(BasicBigInteger& big_int, Limb value) {
+  if (value == 0) {
+    big_int = BasicBigInteger();
+    return;
+  }
+
+  DoubleLimb old_tmp = 0;
+  for (Limb& limb : big_int.number_) {
+    DoubleLimb cur = static_cast<DoubleLimb>(limb) * value + old_tmp;
+    limb = static_cast<Limb>(cur % kRang);
+    old_tmp = cur / kRang;
+  }
+
+  if (old_tmp != 0) {
+    big_int.number_.push_back(static_cast<Limb>(old_tmp));
+  }
+}
+
+// Only for non-negative big_int.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::AddSmall(BasicBigInteger& big_int, Limb value) {
+  DoubleLimb old_tmp = value;
+  for (size_t i = 0; (i < big_int.number_.size()) && (old_tmp != 0); ++i) {
+    DoubleLimb cur = static_cast<DoubleLimb>(big_int.number_[i]) + old_tmp;
+    big_int.number_[i] = static_cast<Limb>(cur % kRang);
+    old_tmp = cur / kRang;
+  }
+
+  if (old_tmp != 0) {
+    big_int.number_.push_back(static_cast<Limb>(old_tmp));
+  }
+  if ((big_int.number_.size() > 1) || (big_int.number_[0] != 0)) {
+    big_int.sign_ = Positive;
+  }
+}
+
+template <typename Limbs>
+int BasicBigInteger<Limbs>::CompareAbs(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2) {
+  return CompareLimbs(big_int1.number_.data(), big_int1.number_.size(), big_int2.number_.data(),
+                      big_int2.number_.size());
+}
+
+// Both without leading zero limbs.
+template <typename Limbs>
+constexpr int BasicBigInteger<Limbs>::CompareLimbs(const Limb* a, size_t n, const Limb* b, size_t m) {
+  if (n != m) {
+    return (n < m ? -1 : 1);
+  }
+
+  for (size_t i = n; i > 0; --i) {
+    if (a[i - 1] != b[i - 1]) {
+      return (a[i - 1] < b[i - 1] ? -1 : 1);
     }
+  }
 
-    for (size_t i = big_int2.number_.size(); i < big_int1.number_.size(); ++i) {
-      if (big_int1.number_[i] != 0) {
-        if ((i != big_int1.number_.size() - 1) || (big_int1.number_[i] - old_tmp != 0)) {
-          new_big_int.number_.emplace_back(big_int1.number_[i] - old_tmp);
-          old_tmp = 0;
-        }
-      } else {
-        if (old_tmp != 0) {
-          new_big_int.number_.emplace_back(kRang - old_tmp);
-        } else {
-          new_big_int.number_.emplace_back(0);
-          old_tmp = 0;
-        }
+  return 0;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::HighLimbs(const BasicBigInteger& big_int, size_t count) {
+  if (big_int.number_.size() <= count) {
+    return BasicBigInteger();
+  }
+
+  return FromLimbs(big_int.number_.data() + count, big_int.number_.size() - count);
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::LowLimbs(const BasicBigInteger& big_int, size_t count) {
+  return FromLimbs(big_int.number_.data(), std::min(count, big_int.number_.size()));
+}
+
+template <typename Limbs>
+constexpr size_t BasicBigInteger<Limbs>::AddLimbs(const Limb* a, size_t n, const Limb* b, size_t m, Limb* out) {
+  if (n < m) {
+    std::swap(a, b);
+    std::swap(n, m);
+  }
+
+  Limb old_tmp = AddCarry(a, b, out, m, 0);
+  size_t i = m;
+  for (; (old_tmp != 0) && (i < n); ++i) {
+    old_tmp = (a[i] == kRang - 1 ? 1 : 0);
+    out[i] = static_cast<Limb>(a[i] + 1 - old_tmp * kRang);
+  }
+  if (out != a) {
+    std::copy(a + i, a + n, out + i);
+  }
+
+  out[n] = old_tmp;
+  return n + old_tmp;
+}
+
+template <typename Limbs>
+constexpr void BasicBigInteger<Limbs>::AddLimbsInPlace(Limb* a, size_t n, const Limb* b, size_t m) {
+  Limb old_tmp = AddCarry(a, b, a, m, 0);
+
+  for (size_t i = m; (old_tmp != 0) && (i < n); ++i) {
+    old_tmp = (a[i] == kRang - 1 ? 1 : 0);
+    a[i] = static_cast<Limb>(a[i] + 1 - old_tmp * kRang);
+  }
+}
+
+template <typename Limbs>
+constexpr void BasicBigInteger<Limbs>::SubLimbsInPlace(Limb* a, size_t n, const Limb* b, size_t m) {
+  Limb old_tmp = SubBorrow(a, b, a, m, 0);
+
+  for (size_t i = m; (old_tmp != 0) && (i < n); ++i) {
+    old_tmp = (a[i] == 0 ? 1 : 0);
+    a[i] = static_cast<Limb>(a[i] + old_tmp * kRang - 1);
+  }
+}
+
+// Leaves big_int moved-from, as after the move constructor.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::Recycle(BasicBigInteger& big_int) {
+  if ((big_int.number_.capacity() > SpareLimbs().capacity()) &&
+      (big_int.number_.resource() == SpareLimbs().resource())) {
+    std::swap(SpareLimbs(), big_int.number_);
+  }
+  big_int.number_.clear();
+  big_int.sign_ = Zero;
+}
+
+// a = b - a, where b >= a and both have n limbs.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::ReverseSubLimbsInPlace(Limb* a, const Limb* b, size_t n) {
+  SubBorrow(b, a, a, n, 0);
+}
+
+// Binary limbs form an add-with-carry chain, four limbs per iteration so that the stores
+// stay off it; decimal limbs go eight at a time through AVX2 when the CPU has it.
+template <typename Limbs>
+constexpr typename Limbs::Limb BasicBigInteger<Limbs>::AddCarry(const Limb* a, const Limb* b, Limb* out, size_t n,
+                                                                Limb carry) {
+  size_t i = 0;
+#ifdef BIGINTEGER_X86_SIMD
+  if (!std::is_constant_evaluated()) {
+    if constexpr (Limbs::kDecimalDigits == 0) {
+      unsigned char flag = static_cast<unsigned char>(carry);
+      for (; i + 4 <= n; i += 4) {
+        unsigned long long value0, value1, value2, value3;
+        flag = _addcarry_u64(flag, a[i], b[i], &value0);
+        flag = _addcarry_u64(flag, a[i + 1], b[i + 1], &value1);
+        flag = _addcarry_u64(flag, a[i + 2], b[i + 2], &value2);
+        flag = _addcarry_u64(flag, a[i + 3], b[i + 3], &value3);
+        out[i] = value0;
+        out[i + 1] = value1;
+        out[i + 2] = value2;
+        out[i + 3] = value3;
       }
+      for (; i < n; ++i) {
+        unsigned long long value;
+        flag = _addcarry_u64(flag, a[i], b[i], &value);
+        out[i] = value;
+      }
+      return flag;
+    } else if ((n >= 16) && HasAvx2()) {
+      return AddCarryAvx2(a, b, out, n, carry);
     }
-  } else if (big_int1.number_.size() < big_int2.number_.size()) {
-    new_big_int = -PositivePlusNegative(big_int2, big_int1);
-  } else {
-    if (big_int1 < (-big_int2)) {
-      return -PositivePlusNegative(-big_int2, -big_int1);
-    }
-    new_big_int.sign_ = Positive;
+  }
+#endif
 
-    for (size_t i = 0; i < big_int1.number_.size(); ++i) {
-      if (big_int1.number_[i] != 0) {
-        if (big_int1.number_[i] - old_tmp < big_int2.number_[i]) {
-          new_big_int.number_.emplace_back(kRang + big_int1.number_[i] - old_tmp - big_int2.number_[i]);
-          old_tmp = 1;
-        } else {
-          new_big_int.number_.emplace_back(big_int1.number_[i] - old_tmp - big_int2.number_[i]);
-          old_tmp = 0;
-        }
-      } else {
-        if ((old_tmp != 0) || (big_int2.number_[i] != 0)) {
-          new_big_int.number_.emplace_back(kRang - old_tmp - big_int2.number_[i]);
-          old_tmp = 1;
-        } else {
-          new_big_int.number_.emplace_back(0);
-          old_tmp = 0;
-        }
+  for (; i < n; ++i) {
+    DoubleLimb value = static_cast<DoubleLimb>(a[i]) + b[i] + carry;
+    carry = (value >= kRang ? 1 : 0);
+    out[i] = static_cast<Limb>(value - carry * kRang);
+  }
+  return carry;
+}
+
+template <typename Limbs>
+constexpr typename Limbs::Limb BasicBigInteger<Limbs>::SubBorrow(const Limb* a, const Limb* b, Limb* out, size_t n,
+                                                                 Limb borrow) {
+  size_t i = 0;
+#ifdef BIGINTEGER_X86_SIMD
+  if (!std::is_constant_evaluated()) {
+    if constexpr (Limbs::kDecimalDigits == 0) {
+      unsigned char flag = static_cast<unsigned char>(borrow);
+      for (; i + 4 <= n; i += 4) {
+        unsigned long long value0, value1, value2, value3;
+        flag = _subborrow_u64(flag, a[i], b[i], &value0);
+        flag = _subborrow_u64(flag, a[i + 1], b[i + 1], &value1);
+        flag = _subborrow_u64(flag, a[i + 2], b[i + 2], &value2);
+        flag = _subborrow_u64(flag, a[i + 3], b[i + 3], &value3);
+        out[i] = value0;
+        out[i + 1] = value1;
+        out[i + 2] = value2;
+        out[i + 3] = value3;
+      }
+      for (; i < n; ++i) {
+        unsigned long long value;
+        flag = _subborrow_u64(flag, a[i], b[i], &value);
+        out[i] = value;
       }
+      return flag;
+    } else if ((n >= 16) && HasAvx2()) {
+      return SubBorrowAvx2(a, b, out, n, borrow);
     }
   }
+#endif
+
+  for (; i < n; ++i) {
+    DoubleLimb value = static_cast<DoubleLimb>(b[i]) + borrow;
+    Limb limb = a[i];
+    borrow = (limb < value ? 1 : 0);
+    out[i] = static_cast<Limb>(limb + borrow * kRang - value);
+  }
+  return borrow;
+}
+
+#ifdef BIGINTEGER_X86_SIMD
+template <typename Limbs>
+bool BasicBigInteger<Limbs>::HasAvx2() {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+}
+
+// Carry-lookahead over eight base 10^9 lanes: with G the lanes whose sum reaches the base
+// and P those that sit one below it, ((G << 1 | carry) + P) ^ P marks every lane that
+// receives a carry, and bit 8 is the carry out.
+template <typename Limbs>
+typename Limbs::Limb BasicBigInteger<Limbs>::AddCarryAvx2(const Limb* a, const Limb* b, Limb* out, size_t n,
+                                                        Limb carry) {
+  const __m256i base = _mm256_set1_epi32(static_cast<int>(kRang));
+  const __m256i top = _mm256_set1_epi32(static_cast<int>(kRang - 1));
+  const __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i sum = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                   _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+    unsigned generate = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(sum, top))));
+    unsigned propagate = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(sum, top))));
+    unsigned carries = (((generate << 1) | carry) + propagate) ^ propagate;
+    carry = (carries >> 8) & 1;
+
+    __m256i incoming = _mm256_and_si256(_mm256_set1_epi32(static_cast<int>(carries)), lanes);
+    sum = _mm256_sub_epi32(sum, _mm256_cmpeq_epi32(incoming, lanes));
+    sum = _mm256_sub_epi32(sum, _mm256_and_si256(_mm256_cmpgt_epi32(sum, top), base));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), sum);
+  }
+
+  for (; i < n; ++i) {
+    DoubleLimb value = static_cast<DoubleLimb>(a[i]) + b[i] + carry;
+    carry = (value >= kRang ? 1 : 0);
+    out[i] = static_cast<Limb>(value - carry * kRang);
+  }
+  return carry;
+}
+
+// Same lookahead for borrows: G are the lanes with a - b < 0, P those with a - b == 0.
+template <typename Limbs>
+typename Limbs::Limb BasicBigInteger<Limbs>::SubBorrowAvx2(const Limb* a, const Limb* b, Limb* out, size_t n,
+                                                         Limb borrow) {
+  const __m256i base = _mm256_set1_epi32(static_cast<int>(kRang));
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i diff = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+    unsigned generate = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(zero, diff))));
+    unsigned propagate = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(diff, zero))));
+    unsigned borrows = (((generate << 1) | borrow) + propagate) ^ propagate;
+    borrow = (borrows >> 8) & 1;
+
+    __m256i incoming = _mm256_and_si256(_mm256_set1_epi32(static_cast<int>(borrows)), lanes);
+    diff = _mm256_add_epi32(diff, _mm256_cmpeq_epi32(incoming, lanes));
+    diff = _mm256_add_epi32(diff, _mm256_and_si256(_mm256_cmpgt_epi32(zero, diff), base));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), diff);
+  }
+
+  for (; i < n; ++i) {
+    DoubleLimb value = static_cast<DoubleLimb>(b[i]) + borrow;
+    Limb limb = a[i];
+    borrow = (limb < value ? 1 : 0);
+    out[i] = static_cast<Limb>(limb + borrow * kRang - value);
+  }
+  return borrow;
+}
+#endif
+
+template <typename Limbs>
+typename Limbs::Limb* BasicBigInteger<Limbs>::Scratch::Take(size_t size) {
+  while ((block_ < blocks_.size()) && (used_ + size > sizes_[block_])) {
+    ++block_;
+    used_ = 0;
+  }
+
+  if (block_ == blocks_.size()) {
+    size_t block_size = std::max(size, (sizes_.empty() ? size_t(1024) : 2 * sizes_.back()));
+    blocks_.push_back(std::make_unique<Limb[]>(block_size));
+    sizes_.push_back(block_size);
+    used_ = 0;
+  }
+
+  Limb* data = blocks_[block_].get() + used_;
+  used_ += size;
+  return data;
+}
+
+template <typename Limbs>
+typename BasicBigInteger<Limbs>::Scratch& BasicBigInteger<Limbs>::ScratchSpace() {
+  static thread_local Scratch scratch;
+  return scratch;
+}
+
+// Pinned to the default resource: a buffer outliving the arena it came from would dangle.
+template <typename Limbs>
+typename BasicBigInteger<Limbs>::Storage& BasicBigInteger<Limbs>::SpareLimbs() {
+  static thread_local Storage spare(std::pmr::get_default_resource());
+  return spare;
+}
+
+template <typename Limbs>
+std::unique_ptr<ThreadPool>& BasicBigInteger<Limbs>::Pool() {
+  static std::unique_ptr<ThreadPool> pool;
+  return pool;
+}
+
+template <typename Limbs>
+size_t& BasicBigInteger<Limbs>::ParallelThreshold() {
+  static size_t threshold = kParallelThreshold;
+  return threshold;
+}
+
+template <typename Limbs>
+template <typename Body>
+void BasicBigInteger<Limbs>::ForEach(size_t count, bool parallel, const Body& body) {
+  if (parallel && Pool()) {
+    Pool()->ParallelFor(count, body);
+    return;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    body(i);
+  }
+}
+
+template <typename Limbs>
+template <typename Body>
+void BasicBigInteger<Limbs>::ForEachRange(size_t count, size_t work, const Body& body) {
+  size_t chunks = (Parallel(work) ? std::min(count, kParallelChunks) : std::min<size_t>(count, 1));
+  ForEach(chunks, chunks > 1, [&](size_t chunk) {
+    body(count * chunk / chunks, count * (chunk + 1) / chunks);
+  });
+}
+
+template <typename Limbs>
+void BasicBigInteger<Limbs>::set_parallelism(size_t threads, size_t threshold) {
+  Pool() = (threads > 1 ? std::make_unique<ThreadPool>(threads - 1) : nullptr);
+  ParallelThreshold() = threshold;
+}
+
+template <typename Limbs>
+size_t BasicBigInteger<Limbs>::parallelism() {
+  return (Pool() ? Pool()->size() : 1);
+}
+
+template <typename Limbs>
+std::pmr::memory_resource* BasicBigInteger<Limbs>::set_memory_resource(std::pmr::memory_resource* resource) {
+  std::pmr::memory_resource* previous = memory_resource();
+  LimbResource() = resource;
+  return previous;
+}
+
+template <typename Limbs>
+std::pmr::memory_resource* BasicBigInteger<Limbs>::memory_resource() {
+  return (LimbResource() != nullptr ? LimbResource() : std::pmr::get_default_resource());
+}
+
+// out[0, n + m) = a * b. A forced algorithm is used on every level it is suited for,
+// smaller subproducts fall back to the cheaper tiers.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::MulLimbs(const Limb* a, size_t n, const Limb* b, size_t m, Limb* out,
+                                    Algorithm algorithm) {
+  if (n < m) {
+    std::swap(a, b);
+    std::swap(n, m);
+  }
+
+  if ((algorithm == Algorithm::Schoolbook) || (m < kKaratsubaThreshold)) {
+    MulSchoolbook(a, n, b, m, out);
+    return;
+  }
+
+  Algorithm tier = algorithm;
+  if ((tier == Algorithm::Auto) || ((tier == Algorithm::ToomCook3) && (m < kToomCook3Threshold))) {
+    if (m < kToomCook3Threshold) {
+      tier = Algorithm::Karatsuba;
+    } else if (m < kNttThreshold) {
+      tier = Algorithm::ToomCook3;
+    } else {
+      tier = Algorithm::Ntt;
+    }
+  }
+
+  if ((tier == Algorithm::Ntt) && ((n + m) * Limbs::kNttSplit > kNttMaxLength)) {
+    tier = Algorithm::ToomCook3;
+  }
+
+  switch (tier) {
+    case Algorithm::Karatsuba:
+      MulKaratsuba(a, n, b, m, out, algorithm);
+      break;
+    case Algorithm::ToomCook3:
+      MulToomCook3(a, n, b, m, out, algorithm);
+      break;
+    default:
+      MulNtt(a, n, b, m, out);
+      break;
+  }
+}
+
+template <typename Limbs>
+constexpr void BasicBigInteger<Limbs>::MulSchoolbook(const Limb* a, size_t n, const Limb* b, size_t m, Limb* out) {
+  std::fill(out, out + n + m, 0);
+
+  for (size_t i = 0; i < n; ++i) {
+    DoubleLimb old_tmp = 0;
+    DoubleLimb cur = a[i];
+
+    for (size_t j = 0; j < m; ++j) {
+      DoubleLimb value = cur * b[j] + out[i + j] + old_tmp;
+      out[i + j] = static_cast<Limb>(value % kRang);
+      old_tmp = value / kRang;
+    }
+
+    out[i + m] = static_cast<Limb>(old_tmp);
+  }
+}
+
+// Cuts the longer operand into pieces of the shorter one's length.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::MulUnbalanced(const Limb* a, size_t n, const Limb* b, size_t m, Limb* out,
+                                    Algorithm algorithm) {
+  std::fill(out, out + n + m, 0);
+  Scratch& scratch = ScratchSpace();
+  auto mark = scratch.Position();
+  Limb* tmp = scratch.Take(2 * m);
+
+  for (size_t i = 0; i < n; i += m) {
+    size_t len = std::min(m, n - i);
+    MulLimbs(a + i, len, b, m, tmp, algorithm);
+    AddLimbsInPlace(out + i, n + m - i, tmp, len + m);
+  }
+
+  scratch.Release(mark);
+}
+
+// a = a1 * B^h + a0, b = b1 * B^h + b0,
+// a * b = a1b1 * B^2h + ((a0 + a1)(b0 + b1) - a0b0 - a1b1) * B^h + a0b0.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::MulKaratsuba(const Limb* a, size_t n, const Limb* b, size_t m, Limb* out,
+                                    Algorithm algorithm) {
+  size_t half = (n + 1) / 2;
+  if (m <= half) {
+    MulUnbalanced(a, n, b, m, out, algorithm);
+    return;
+  }
+
+  Scratch& scratch = ScratchSpace();
+  auto mark = scratch.Position();
+  Limb* sum_a = scratch.Take(half + 1);
+  Limb* sum_b = scratch.Take(half + 1);
+  size_t len_a = AddLimbs(a, half, a + half, n - half, sum_a);
+  size_t len_b = AddLimbs(b, half, b + half, m - half, sum_b);
+
+  Limb* middle = scratch.Take(len_a + len_b);
+
+  // The three subproducts write disjoint ranges; each thread keeps its own scratch.
+  ForEach(3, Parallel(m), [&](size_t part) {
+    if (part == 0) {
+      MulLimbs(a, half, b, half, out, algorithm);
+    } else if (part == 1) {
+      MulLimbs(a + half, n - half, b + half, m - half, out + 2 * half, algorithm);
+    } else {
+      MulLimbs(sum_a, len_a, sum_b, len_b, middle, algorithm);
+    }
+  });
+
+  SubLimbsInPlace(middle, len_a + len_b, out, 2 * half);
+  SubLimbsInPlace(middle, len_a + len_b, out + 2 * half, n + m - 2 * half);
+
+  size_t len_middle = len_a + len_b;
+  while ((len_middle > 0) && (middle[len_middle - 1] == 0)) {
+    --len_middle;
+  }
+  AddLimbsInPlace(out + half, n + m - half, middle, len_middle);
+  scratch.Release(mark);
+}
+
+// Toom-3 with evaluation points 0, 1, -1, -2, inf and Bodrato's interpolation sequence.
+// Evaluated values may be negative, so the pieces are handled as signed BigIntegers.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::MulToomCook3(const Limb* a, size_t n, const Limb* b, size_t m, Limb* out,
+                                    Algorithm algorithm) {
+  size_t third = (n + 2) / 3;
+  if (m <= 2 * third) {
+    MulUnbalanced(a, n, b, m, out, algorithm);
+    return;
+  }
+
+  BasicBigInteger a0 = FromLimbs(a, third);
+  BasicBigInteger a1 = FromLimbs(a + third, third);
+  BasicBigInteger a2 = FromLimbs(a + 2 * third, n - 2 * third);
+  BasicBigInteger b0 = FromLimbs(b, third);
+  BasicBigInteger b1 = FromLimbs(b + third, third);
+  BasicBigInteger b2 = FromLimbs(b + 2 * third, m - 2 * third);
+
+  BasicBigInteger tmp_a = a0 + a2;
+  BasicBigInteger tmp_b = b0 + b2;
+  BasicBigInteger a_m1 = tmp_a - a1;
+  BasicBigInteger b_m1 = tmp_b - b1;
+  BasicBigInteger a_m2 = a_m1 + a2;
+  BasicBigInteger b_m2 = b_m1 + b2;
+  a_m2 += a_m2;
+  b_m2 += b_m2;
+  a_m2 -= a0;
+  b_m2 -= b0;
+
+  BasicBigInteger a_1 = tmp_a + a1;
+  BasicBigInteger b_1 = tmp_b + b1;
+  const BasicBigInteger* factors[5][2] = {{&a0, &b0}, {&a_1, &b_1}, {&a_m1, &b_m1}, {&a_m2, &b_m2}, {&a2, &b2}};
+  BasicBigInteger products[5];
+  ForEach(5, Parallel(m), [&](size_t point) {
+    products[point] = multiply(*factors[point][0], *factors[point][1], algorithm);
+  });
+
+  BasicBigInteger& r0 = products[0];
+  BasicBigInteger& r1 = products[1];
+  BasicBigInteger& r_m1 = products[2];
+  BasicBigInteger& r_m2 = products[3];
+  BasicBigInteger& r_inf = products[4];
+
+  BasicBigInteger r3 = r_m2 - r1;
+  DivSmall(r3, 3);
+  r1 -= r_m1;
+  DivSmall(r1, 2);
+  BasicBigInteger r2 = r_m1 - r0;
+  r3 = r2 - r3;
+  DivSmall(r3, 2);
+  r3 += r_inf;
+  r3 += r_inf;
+  r2 += r1;
+  r2 -= r_inf;
+  r1 -= r3;
+
+  std::fill(out, out + n + m, 0);
+  const BasicBigInteger* coefficients[] = {&r0, &r1, &r2, &r3, &r_inf};
+  for (size_t i = 0; i < 5; ++i) {
+    if (coefficients[i]->sign_ != Zero) {
+      AddLimbsInPlace(out + i * third, n + m - i * third, coefficients[i]->number_.data(),
+                      coefficients[i]->number_.size());
+    }
+  }
+}
+
+template <typename Limbs>
+constexpr uint32_t BasicBigInteger<Limbs>::PowMod(uint32_t base, uint64_t exp, uint32_t mod) {
+  uint64_t result = 1;
+  uint64_t cur = base % mod;
+
+  while (exp > 0) {
+    if (exp & 1) {
+      result = result * cur % mod;
+    }
+    cur = cur * cur % mod;
+    exp >>= 1;
+  }
+
+  return static_cast<uint32_t>(result);
+}
+
+// With parallel set, the bit reversal and every butterfly stage are cut into
+// kParallelChunks index ranges that run on the pool.
+template <typename Limbs>
+template <uint32_t kMod>
+void BasicBigInteger<Limbs>::Ntt(std::vector<uint32_t>& values, bool invert, bool parallel) {
+  size_t size = values.size();
+  size_t chunks = (parallel && (size >= 2 * kParallelChunks) ? kParallelChunks : 1);
+  size_t log = static_cast<size_t>(std::countr_zero(size));
+
+  size_t chunk_size = size / chunks;
+  ForEach(chunks, chunks > 1, [&](size_t chunk) {
+    size_t begin = chunk * chunk_size;
+    size_t j = 0;
+    for (size_t bit = 0; bit < log; ++bit) {
+      j |= ((begin >> bit) & 1) << (log - 1 - bit);
+    }
+
+    for (size_t i = begin; i < begin + chunk_size; ++i) {
+      if (i > begin) {
+        size_t bit = size >> 1;
+        for (; j & bit; bit >>= 1) {
+          j ^= bit;
+        }
+        j ^= bit;
+      }
+
+      if (i < j) {
+        std::swap(values[i], values[j]);
+      }
+    }
+  });
+
+  std::vector<uint32_t> roots(size / 2);
+  size_t butterflies = size / 2;
+  size_t butterfly_chunk = butterflies / chunks;
+  for (size_t len = 2, log_half = 0; len <= size; len <<= 1, ++log_half) {
+    uint32_t root = PowMod(3, (kMod - 1) / len, kMod);
+    if (invert) {
+      root = PowMod(root, kMod - 2, kMod);
+    }
+
+    size_t half = len / 2;
+    roots[0] = 1;
+    for (size_t j = 1; j < half; ++j) {
+      roots[j] = static_cast<uint32_t>(static_cast<uint64_t>(roots[j - 1]) * root % kMod);
+    }
+
+    // Butterfly t pairs values[i + j] and values[i + j + half] with i = (t / half) * len, j = t % half.
+    ForEach(chunks, chunks > 1, [&](size_t chunk) {
+      size_t t = chunk * butterfly_chunk;
+      size_t end = t + butterfly_chunk;
+      while (t < end) {
+        size_t i = (t >> log_half) * len;
+        size_t j = t & (half - 1);
+        size_t stop = std::min(half, j + (end - t));
+        t += stop - j;
+
+        for (; j < stop; ++j) {
+          uint32_t u = values[i + j];
+          uint32_t v = static_cast<uint32_t>(static_cast<uint64_t>(values[i + j + half]) * roots[j] % kMod);
+          values[i + j] = (u + v >= kMod ? u + v - kMod : u + v);
+          values[i + j + half] = (u >= v ? u - v : u + kMod - v);
+        }
+      }
+    });
+  }
+
+  if (invert) {
+    uint64_t size_inv = PowMod(static_cast<uint32_t>(size % kMod), kMod - 2, kMod);
+    ForEach(chunks, chunks > 1, [&](size_t chunk) {
+      for (size_t i = chunk * chunk_size; i < (chunk + 1) * chunk_size; ++i) {
+        values[i] = static_cast<uint32_t>(values[i] * size_inv % kMod);
+      }
+    });
+  }
+}
+
+// Convolves the limbs modulo three NTT primes and restores every coefficient with Garner's CRT.
+// Each limb enters the transform as Limbs::kNttSplit digits in base Limbs::kNttBase.
+// In parallel mode the three residue convolutions run side by side and so does the
+// per-coefficient CRT; only the final carry propagation stays serial.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::MulNtt(const Limb* a, size_t n, const Limb* b, size_t m, Limb* out) {
+  constexpr size_t kSplit = Limbs::kNttSplit;
+  constexpr uint64_t kDigit = Limbs::kNttBase;
+
+  size_t size = 1;
+  while (size < (n + m) * kSplit) {
+    size <<= 1;
+  }
+
+  auto split = [](const Limb* limbs, size_t count) {
+    std::vector<uint32_t> digits(count * kSplit);
+    for (size_t i = 0; i < count; ++i) {
+      Limb limb = limbs[i];
+      for (size_t j = 0; j < kSplit; ++j) {
+        digits[i * kSplit + j] = static_cast<uint32_t>(limb % kDigit);
+        limb /= kDigit;
+      }
+    }
+    return digits;
+  };
+
+  bool parallel = Parallel(m);
+  bool square = (a == b) && (n == m);
+  std::vector<uint32_t> digits_a = split(a, n);
+  std::vector<uint32_t> digits_b = (square ? std::vector<uint32_t>() : split(b, m));
+  std::vector<uint32_t> residues[3];
+
+  auto convolve = [&](auto mod_tag, std::vector<uint32_t>& result) {
+    constexpr uint32_t kMod = decltype(mod_tag)::value;
+    result.assign(size, 0);
+    for (size_t i = 0; i < digits_a.size(); ++i) {
+      result[i] = digits_a[i] % kMod;
+    }
+    Ntt<kMod>(result, false, parallel);
+
+    if (square) {
+      for (uint32_t& value : result) {
+        value = static_cast<uint32_t>(static_cast<uint64_t>(value) * value % kMod);
+      }
+    } else {
+      std::vector<uint32_t> other(size, 0);
+      for (size_t i = 0; i < digits_b.size(); ++i) {
+        other[i] = digits_b[i] % kMod;
+      }
+      Ntt<kMod>(other, false, parallel);
+      for (size_t i = 0; i < size; ++i) {
+        result[i] = static_cast<uint32_t>(static_cast<uint64_t>(result[i]) * other[i] % kMod);
+      }
+    }
+
+    Ntt<kMod>(result, true, parallel);
+  };
+
+  ForEach(3, parallel, [&](size_t residue) {
+    if (residue == 0) {
+      convolve(std::integral_constant<uint32_t, kNttMod1>(), residues[0]);
+    } else if (residue == 1) {
+      convolve(std::integral_constant<uint32_t, kNttMod2>(), residues[1]);
+    } else {
+      convolve(std::integral_constant<uint32_t, kNttMod3>(), residues[2]);
+    }
+  });
+
+  constexpr uint64_t kMod12 = static_cast<uint64_t>(kNttMod1) * kNttMod2;
+  constexpr uint64_t kInv1 = PowMod(kNttMod1 % kNttMod2, kNttMod2 - 2, kNttMod2);
+  constexpr uint64_t kInv12 = PowMod(static_cast<uint32_t>(kMod12 % kNttMod3), kNttMod3 - 2, kNttMod3);
+
+  // Coefficient k is x3 * kMod12 + low[k], with x3 left in residues[2][k].
+  size_t count = (n + m) * kSplit;
+  std::vector<uint64_t> low(count);
+  size_t chunks = (parallel ? kParallelChunks : 1);
+  size_t chunk_size = (count + chunks - 1) / chunks;
+  ForEach(chunks, parallel, [&](size_t chunk) {
+    for (size_t k = chunk * chunk_size; k < std::min(count, (chunk + 1) * chunk_size); ++k) {
+      uint64_t x1 = residues[0][k];
+      uint64_t x2 = (residues[1][k] + kNttMod2 - x1 % kNttMod2) * kInv1 % kNttMod2;
+      uint64_t x12 = x1 + x2 * kNttMod1;
+      residues[2][k] = static_cast<uint32_t>((residues[2][k] + kNttMod3 - x12 % kNttMod3) * kInv12 % kNttMod3);
+      low[k] = x12;
+    }
+  });
+
+  unsigned __int128 old_tmp = 0;
+  for (size_t i = 0; i < n + m; ++i) {
+    Limb limb = 0;
+    Limb scale = 1;
+
+    for (size_t j = 0; j < kSplit; ++j) {
+      size_t k = i * kSplit + j;
+      unsigned __int128 value = static_cast<unsigned __int128>(residues[2][k]) * kMod12 + low[k] + old_tmp;
+      limb += static_cast<Limb>(value % kDigit) * scale;
+      scale *= kDigit;
+      old_tmp = value / kDigit;
+    }
+
+    out[i] = limb;
+  }
+}
+
+// u = a * d and v = b * d with d chosen so that v's top limb is at least kRang / 2,
+// which keeps every estimated quotient limb at most two above the real one.
+template <typename Limbs>
+constexpr void BasicBigInteger<Limbs>::DivKnuth(const Limb* a, size_t n, const Limb* b, size_t m, Limb* quotient,
+                                                Limb* remainder, Limb* work) {
+  Limb d = static_cast<Limb>(kRang / (static_cast<DoubleLimb>(b[m - 1]) + 1));
+  Limb* u = work;
+  Limb* v = work + n + 1;
+
+  DoubleLimb old_tmp = 0;
+  for (size_t i = 0; i < n; ++i) {
+    DoubleLimb value = static_cast<DoubleLimb>(a[i]) * d + old_tmp;
+    u[i] = static_cast<Limb>(value % kRang);
+    old_tmp = value / kRang;
+  }
+  u[n] = static_cast<Limb>(old_tmp);
+
+  old_tmp = 0;
+  for (size_t i = 0; i < m; ++i) {
+    DoubleLimb value = static_cast<DoubleLimb>(b[i]) * d + old_tmp;
+    v[i] = static_cast<Limb>(value % kRang);
+    old_tmp = value / kRang;
+  }
+
+  for (size_t j = n - m + 1; j > 0; --j) {
+    Limb* cur = u + j - 1;
+    DoubleLimb top = static_cast<DoubleLimb>(cur[m]) * kRang + cur[m - 1];
+    DoubleLimb q_hat = top / v[m - 1];
+    DoubleLimb r_hat = top % v[m - 1];
+
+    while ((q_hat >= kRang) || (q_hat * v[m - 2] > r_hat * kRang + cur[m - 2])) {
+      --q_hat;
+      r_hat += v[m - 1];
+      if (r_hat >= kRang) {
+        break;
+      }
+    }
+
+    Limb borrow = 0;
+    old_tmp = 0;
+    for (size_t i = 0; i < m; ++i) {
+      DoubleLimb product = q_hat * v[i] + old_tmp;
+      old_tmp = product / kRang;
+      DoubleLimb value = (product % kRang) + borrow;
+      borrow = (cur[i] < value ? 1 : 0);
+      cur[i] = static_cast<Limb>(cur[i] + borrow * kRang - value);
+    }
+    old_tmp += borrow;
+
+    // The top limb of the partial remainder is zero after every step, so only the sign matters.
+    if (cur[m] < old_tmp) {
+      --q_hat;
+      Limb carry = 0;
+      for (size_t i = 0; i < m; ++i) {
+        DoubleLimb sum = static_cast<DoubleLimb>(cur[i]) + v[i] + carry;
+        carry = (sum >= kRang ? 1 : 0);
+        cur[i] = static_cast<Limb>(sum - carry * kRang);
+      }
+    }
+
+    cur[m] = 0;
+    quotient[j - 1] = static_cast<Limb>(q_hat);
+  }
+
+  DoubleLimb rest = 0;
+  for (size_t i = m; i > 0; --i) {
+    DoubleLimb value = rest * kRang + u[i - 1];
+    remainder[i - 1] = static_cast<Limb>(value / d);
+    rest = value % d;
+  }
+}
+
+template <typename Limbs>
+void BasicBigInteger<Limbs>::DivModAbs(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2, BasicBigInteger& quotient,
+                           BasicBigInteger& remainder) {
+  size_t n = big_int1.number_.size();
+  size_t m = big_int2.number_.size();
+
+  if (CompareAbs(big_int1, big_int2) < 0) {
+    quotient = BasicBigInteger();
+    remainder = Abs(big_int1);
+  } else if (m == 1) {
+    quotient = Abs(big_int1);
+    Limb rest = DivSmall(quotient, big_int2.number_[0]);
+    remainder = FromLimbs(&rest, 1);
+  } else if ((m < kBurnikelZieglerThreshold) || (n - m < kBurnikelZieglerThreshold)) {
+    DivModKnuth(big_int1, big_int2, quotient, remainder);
+  } else {
+    DivBurnikelZiegler(Abs(big_int1), Abs(big_int2), quotient, remainder);
+  }
+
+  // Magnitudes: a zero comes out Zero even from an operand signed otherwise.
+  quotient.Normalize(Positive);
+  remainder.Normalize(Positive);
+}
+
+template <typename Limbs>
+void BasicBigInteger<Limbs>::DivModKnuth(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2, BasicBigInteger& quotient,
+                             BasicBigInteger& remainder) {
+  size_t n = big_int1.number_.size();
+  size_t m = big_int2.number_.size();
+
+  if (CompareAbs(big_int1, big_int2) < 0) {
+    quotient = BasicBigInteger();
+    remainder = Abs(big_int1);
+    return;
+  }
+
+  Scratch& scratch = ScratchSpace();
+  auto mark = scratch.Position();
+  Limb* q = scratch.Take(n - m + 1);
+  Limb* r = scratch.Take(m);
+  DivKnuth(big_int1.number_.data(), n, big_int2.number_.data(), m, q, r, scratch.Take(n + m + 1));
+  quotient = FromLimbs(q, n - m + 1);
+  remainder = FromLimbs(r, m);
+  scratch.Release(mark);
+}
+
+// Burnikel-Ziegler: the divisor is padded to block = j * 2^k limbs, j < kBurnikelZieglerThreshold,
+// so that Div2n1n can halve it k times before falling back to Knuth.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::DivBurnikelZiegler(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2, BasicBigInteger& quotient,
+                                    BasicBigInteger& remainder) {
+  size_t m = big_int2.number_.size();
+  size_t k = 0;
+  while ((m >> k) >= kBurnikelZieglerThreshold) {
+    ++k;
+  }
+  size_t block = ((m + (size_t(1) << k) - 1) >> k) << k;
+  size_t sigma = block - m;
+
+  Limb d = static_cast<Limb>(kRang / (static_cast<DoubleLimb>(big_int2.number_.back()) + 1));
+  BasicBigInteger divisor = big_int2;
+  BasicBigInteger dividend = big_int1;
+  MulSmall(divisor, d);
+  MulSmall(dividend, d);
+  ShiftLimbs(divisor, sigma);
+  ShiftLimbs(dividend, sigma);
+
+  // One spare limb keeps the top block below the divisor.
+  size_t blocks = std::max<size_t>(2, (dividend.number_.size() + block) / block);
+  Scratch& scratch = ScratchSpace();
+  auto mark = scratch.Position();
+  Limb* q = scratch.Take(blocks * block);
+  std::fill(q, q + blocks * block, Limb(0));
+
+  BasicBigInteger cur = HighLimbs(dividend, (blocks - 2) * block);
+  for (size_t i = blocks - 1; i > 0; --i) {
+    BasicBigInteger q_part;
+    Div2n1n(cur, divisor, block, q_part, remainder);
+
+    if (q_part.sign_ != Zero) {
+      std::copy(q_part.number_.begin(), q_part.number_.end(), q + (i - 1) * block);
+    }
+
+    if (i > 1) {
+      cur = std::move(remainder);
+      ShiftLimbs(cur, block);
+      cur += LowLimbs(HighLimbs(dividend, (i - 2) * block), block);
+    }
+  }
+
+  quotient = FromLimbs(q, blocks * block);
+  scratch.Release(mark);
+  remainder = HighLimbs(remainder, sigma);
+  DivSmall(remainder, d);
+}
+
+// a < b * kRang^n, b has n limbs and is normalized.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::Div2n1n(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2, size_t n, BasicBigInteger& quotient,
+                         BasicBigInteger& remainder) {
+  if ((n % 2 != 0) || (n < kBurnikelZieglerThreshold)) {
+    DivModKnuth(big_int1, big_int2, quotient, remainder);
+    return;
+  }
+
+  size_t half = n / 2;
+  BasicBigInteger q_high;
+  BasicBigInteger rest;
+  Div3n2n(HighLimbs(big_int1, half), big_int2, half, q_high, rest);
+
+  ShiftLimbs(rest, half);
+  rest += LowLimbs(big_int1, half);
+  Div3n2n(rest, big_int2, half, quotient, remainder);
+
+  ShiftLimbs(q_high, half);
+  quotient += q_high;
+}
+
+// a < b * kRang^half, b has 2 * half limbs and is normalized.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::Div3n2n(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2, size_t half, BasicBigInteger& quotient,
+                         BasicBigInteger& remainder) {
+  BasicBigInteger b1 = HighLimbs(big_int2, half);
+  BasicBigInteger a12 = HighLimbs(big_int1, half);
+
+  if (CompareAbs(HighLimbs(big_int1, 2 * half), b1) < 0) {
+    Div2n1n(a12, b1, half, quotient, remainder);
+  } else {
+    quotient.number_.assign(half, static_cast<Limb>(kRang - 1));
+    quotient.sign_ = Positive;
+    remainder = a12 + b1;
+    ShiftLimbs(b1, half);
+    remainder -= b1;
+  }
+
+  ShiftLimbs(remainder, half);
+  remainder += LowLimbs(big_int1, half);
+  remainder -= quotient * LowLimbs(big_int2, half);
+
+  while (remainder.sign_ == Negative) {
+    --quotient;
+    remainder += big_int2;
+  }
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::FromWord(uint64_t value) {
+  BasicBigInteger big_int;
+  if (value == 0) {
+    return big_int;
+  }
+
+  big_int.sign_ = Positive;
+  big_int.number_.clear();
+  while (value > 0) {
+    big_int.number_.push_back(static_cast<Limb>(value % kRang));
+    value = static_cast<uint64_t>(value / kRang);
+  }
+
+  return big_int;
+}
+
+// Only for |big_int| < 2^64.
+template <typename Limbs>
+uint64_t BasicBigInteger<Limbs>::ToWord(const BasicBigInteger& big_int) {
+  uint64_t value = 0;
+  for (size_t i = big_int.number_.size(); i > 0; --i) {
+    value = static_cast<uint64_t>(value * kRang + big_int.number_[i - 1]);
+  }
+  return value;
+}
+
+// The decimal backend goes through the binary one's subquadratic from_chars.
+template <typename Limbs>
+std::vector<uint64_t> BasicBigInteger<Limbs>::BinaryWords(const BasicBigInteger& big_int) {
+  if (big_int.sign_ == Zero) {
+    return {};
+  }
+
+  if constexpr (Limbs::kDecimalDigits == 0) {
+    return std::vector<uint64_t>(big_int.number_.begin(), big_int.number_.end());
+  } else {
+    if (big_int.number_.size() <= 2) {
+      return {ToWord(big_int)};
+    }
+
+    std::string str = Abs(big_int).toString();
+    BasicBigInteger<BinaryLimbs> binary;
+    BasicBigInteger<BinaryLimbs>::from_chars(str.data(), str.data() + str.size(), binary);
+    return std::vector<uint64_t>(binary.number_.begin(), binary.number_.end());
+  }
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::FromBinaryWords(const uint64_t* words, size_t count) {
+  if constexpr (Limbs::kDecimalDigits == 0) {
+    return FromLimbs(words, count);
+  } else {
+    while ((count > 0) && (words[count - 1] == 0)) {
+      --count;
+    }
+    if (count <= 1) {
+      return FromWord(count == 0 ? 0 : words[0]);
+    }
+
+    BasicBigInteger<BinaryLimbs> binary = BasicBigInteger<BinaryLimbs>::FromLimbs(words, count);
+    std::string str(BasicBigInteger<BinaryLimbs>::max_chars(binary), '\0');
+    char* last = BasicBigInteger<BinaryLimbs>::to_chars(str.data(), str.data() + str.size(), binary).ptr;
+    BasicBigInteger big_int;
+    from_chars(str.data(), last, big_int);
+    return big_int;
+  }
+}
+
+// Negative operands are complemented on the fly, ~(|x| - 1), and so is a negative result.
+template <typename Limbs>
+template <typename Op>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::Bitwise(const BasicBigInteger& big_int1,
+                                                       const BasicBigInteger& big_int2, Op op) {
+  std::vector<uint64_t> words1;
+  std::vector<uint64_t> words2;
+  const uint64_t* a = nullptr;
+  const uint64_t* b = nullptr;
+  size_t n = 0;
+  size_t m = 0;
+
+  if constexpr (Limbs::kDecimalDigits == 0) {
+    a = big_int1.number_.data();
+    b = big_int2.number_.data();
+    n = (big_int1.sign_ == Zero ? 0 : big_int1.number_.size());
+    m = (big_int2.sign_ == Zero ? 0 : big_int2.number_.size());
+  } else {
+    words1 = BinaryWords(big_int1);
+    words2 = BinaryWords(big_int2);
+    a = words1.data();
+    b = words2.data();
+    n = words1.size();
+    m = words2.size();
+  }
+
+  bool negative1 = (big_int1.sign_ == Negative);
+  bool negative2 = (big_int2.sign_ == Negative);
+  bool negative = (op(negative1 ? ~uint64_t(0) : 0, negative2 ? ~uint64_t(0) : 0) != 0);
+
+  size_t size = std::max(n, m) + 1;
+  std::vector<uint64_t> out(size);
+  uint64_t borrow1 = 1;
+  uint64_t borrow2 = 1;
+  uint64_t old_tmp = 1;
+  for (size_t i = 0; i < size; ++i) {
+    uint64_t x = (i < n ? a[i] : 0);
+    if (negative1) {
+      uint64_t value = x - borrow1;
+      borrow1 = (x < borrow1 ? 1 : 0);
+      x = ~value;
+    }
+
+    uint64_t y = (i < m ? b[i] : 0);
+    if (negative2) {
+      uint64_t value = y - borrow2;
+      borrow2 = (y < borrow2 ? 1 : 0);
+      y = ~value;
+    }
+
+    uint64_t result = op(x, y);
+    if (negative) {
+      result = ~result + old_tmp;
+      old_tmp = (result < old_tmp ? 1 : 0);
+    }
+    out[i] = result;
+  }
+
+  BasicBigInteger big_int = FromBinaryWords(out.data(), size);
+  if (negative) {
+    big_int.sign_ = Negative;
+  }
+  return big_int;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::PowerOfTwo(size_t exponent) {
+  if constexpr (Limbs::kDecimalDigits == 0) {
+    return BasicBigInteger(1) << exponent;
+  }
+
+  BasicBigInteger result = FromWord(uint64_t(1) << (exponent % 63));
+  BasicBigInteger base = FromWord(uint64_t(1) << 63);
+
+  for (exponent /= 63; exponent > 0; exponent >>= 1) {
+    if ((exponent & 1) != 0) {
+      result *= base;
+    }
+    if (exponent > 1) {
+      base *= base;
+    }
+  }
+
+  return result;
+}
+
+// log2 of |big_int| to within a bit, from the limb count and the top limbs.
+template <typename Limbs>
+double BasicBigInteger<Limbs>::ApproxBitLength(const BasicBigInteger& big_int) {
+  size_t size = big_int.number_.size();
+  double top = static_cast<double>(big_int.number_[size - 1]);
+  if (size > 1) {
+    top += static_cast<double>(big_int.number_[size - 2]) / static_cast<double>(kRang);
+  }
+  return static_cast<double>(size - 1) * std::log2(static_cast<double>(kRang)) + std::log2(top);
+}
+
+// The top 60+ bits of big_int1 and the bits of big_int2 at the same positions. Binary words keep
+// 62 bits so that cofactor * limb sums stay within __int128.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::LeadingWords(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2,
+                                          uint64_t& word1, uint64_t& word2) {
+  size_t n = big_int1.number_.size();
+  auto limb = [n](const BasicBigInteger& big_int, size_t offset) -> uint64_t {
+    size_t index = n - 1 - offset;
+    return ((offset < n) && (index < big_int.number_.size()) ? big_int.number_[index] : 0);
+  };
+
+  if constexpr (Limbs::kDecimalDigits != 0) {
+    word1 = limb(big_int1, 0) * kRang + limb(big_int1, 1);
+    word2 = limb(big_int2, 0) * kRang + limb(big_int2, 1);
+  } else {
+    int shift = __builtin_clzll(limb(big_int1, 0));
+    word1 = (shift == 0 ? limb(big_int1, 0) : (limb(big_int1, 0) << shift) | (limb(big_int1, 1) >> (64 - shift))) >> 2;
+    word2 = (shift == 0 ? limb(big_int2, 0) : (limb(big_int2, 0) << shift) | (limb(big_int2, 1) >> (64 - shift))) >> 2;
+  }
+}
+
+// (big_int1, big_int2) = (a * big_int1 + b * big_int2, c * big_int1 + d * big_int2) in one pass over the limbs.
+// Signs are honoured, so the same step serves the signed cofactors of xgcd.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::LehmerStep(BasicBigInteger& big_int1, BasicBigInteger& big_int2, int64_t a, int64_t b,
+                                        int64_t c, int64_t d) {
+  size_t size = std::max(big_int1.number_.size(), big_int2.number_.size());
+  big_int1.number_.resize(size);
+  big_int2.number_.resize(size);
+
+  int sign1 = big_int1.sign_;
+  int sign2 = big_int2.sign_;
+  __int128 old_tmp1 = 0;
+  __int128 old_tmp2 = 0;
+  auto split = [](__int128& value) {
+    __int128 rest = value % static_cast<__int128>(kRang);
+    value /= static_cast<__int128>(kRang);
+    if (rest < 0) {
+      rest += static_cast<__int128>(kRang);
+      --value;
+    }
+    return static_cast<Limb>(rest);
+  };
+
+  for (size_t i = 0; i < size; ++i) {
+    __int128 limb1 = static_cast<__int128>(big_int1.number_[i]) * sign1;
+    __int128 limb2 = static_cast<__int128>(big_int2.number_[i]) * sign2;
+    old_tmp1 += limb1 * a + limb2 * b;
+    old_tmp2 += limb1 * c + limb2 * d;
+    big_int1.number_[i] = split(old_tmp1);
+    big_int2.number_[i] = split(old_tmp2);
+  }
+
+  // A negative result is left in kRang's complement below a negative carry; turn it back into sign and magnitude.
+  auto finish = [&split](BasicBigInteger& big_int, __int128 old_tmp) {
+    big_int.sign_ = (old_tmp < 0 ? Negative : Positive);
+    if (old_tmp < 0) {
+      __int128 borrow = 0;
+      for (Limb& limb : big_int.number_) {
+        __int128 value = -static_cast<__int128>(limb) - borrow;
+        borrow = (value < 0 ? 1 : 0);
+        limb = static_cast<Limb>(value + borrow * static_cast<__int128>(kRang));
+      }
+      old_tmp = -(old_tmp + borrow);
+    }
+
+    while (old_tmp > 0) {
+      big_int.number_.push_back(split(old_tmp));
+    }
+    big_int.Normalize(big_int.sign_);
+  };
+
+  finish(big_int1, old_tmp1);
+  finish(big_int2, old_tmp2);
+}
+
+// Lehmer's algorithm: runs Euclid on the leading words for as long as the quotients are
+// provably those of the full numbers, then applies the collected 2x2 matrix in one pass.
+// cofactor, if given, receives x with x * |big_int1| = gcd (mod |big_int2|).
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::GcdLehmer(BasicBigInteger big_int1, BasicBigInteger big_int2,
+                                                         BasicBigInteger* cofactor) {
+  big_int1.sign_ = (big_int1.IsZero() ? Zero : Positive);
+  big_int2.sign_ = (big_int2.IsZero() ? Zero : Positive);
+
+  BasicBigInteger u0 = 1;
+  BasicBigInteger u1 = 0;
+  if (big_int1 < big_int2) {
+    big_int1.Swap(big_int2);
+    u0.Swap(u1);
+  }
+
+  while (big_int2.sign_ != Zero) {
+    uint64_t word1 = 0;
+    uint64_t word2 = 0;
+    LeadingWords(big_int1, big_int2, word1, word2);
+
+    __int128 x = word1;
+    __int128 y = word2;
+    __int128 a = 1;
+    __int128 b = 0;
+    __int128 c = 0;
+    __int128 d = 1;
+
+    while ((y + c != 0) && (y + d != 0)) {
+      __int128 q = (x + a) / (y + c);
+      if (q != (x + b) / (y + d)) {
+        break;
+      }
+
+      __int128 tmp = a - q * c;
+      a = c;
+      c = tmp;
+      tmp = b - q * d;
+      b = d;
+      d = tmp;
+      tmp = x - q * y;
+      x = y;
+      y = tmp;
+    }
+
+    if (b == 0) {
+      auto [quotient, remainder] = divmod(big_int1, big_int2);
+      big_int1.Swap(big_int2);
+      big_int2 = std::move(remainder);
+      if (cofactor != nullptr) {
+        u0 -= quotient * u1;
+        u0.Swap(u1);
+      }
+      continue;
+    }
+
+    LehmerStep(big_int1, big_int2, static_cast<int64_t>(a), static_cast<int64_t>(b), static_cast<int64_t>(c),
+               static_cast<int64_t>(d));
+    if (cofactor != nullptr) {
+      LehmerStep(u0, u1, static_cast<int64_t>(a), static_cast<int64_t>(b), static_cast<int64_t>(c),
+                 static_cast<int64_t>(d));
+    }
+  }
+
+  if (cofactor != nullptr) {
+    *cofactor = std::move(u0);
+  }
+  return big_int1;
+}
+
+// powers[k] = 10^(19 * 2^k) for k < count, kept between calls so repeated conversions reuse the squarings.
+template <typename Limbs>
+const std::vector<BasicBigInteger<Limbs>>& BasicBigInteger<Limbs>::DecimalPowers(size_t count) {
+  static thread_local std::vector<BasicBigInteger> powers;
+  if (powers.size() >= count) {
+    return powers;
+  }
+
+  // The cache outlives any arena the caller may be running in.
+  std::pmr::memory_resource* resource = std::exchange(LimbResource(), nullptr);
+  if (powers.empty()) {
+    Limb chunk = static_cast<Limb>(kDecimalChunk);
+    powers.push_back(FromLimbs(&chunk, 1));
+  }
+  while (powers.size() < count) {
+    BasicBigInteger square = multiply(powers.back(), powers.back());
+    powers.push_back(std::move(square));
+  }
+  LimbResource() = resource;
+
+  return powers;
+}
+
+// Writes 0 <= value < 10^(19 * 2^level) as exactly 2^level base 10^19 chunks, lowest first.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::ToDecimalChunks(const BasicBigInteger& big_int, const std::vector<BasicBigInteger>& powers,
+                                             size_t level, uint64_t* chunks) {
+  size_t count = size_t(1) << level;
+
+  if (big_int.number_.size() <= kRadixConversionThreshold) {
+    BasicBigInteger cur = big_int;
+    for (size_t i = 0; i < count; ++i) {
+      chunks[i] = static_cast<uint64_t>(DivSmall(cur, static_cast<Limb>(kDecimalChunk)));
+    }
+    return;
+  }
+
+  auto [high, low] = divmod(big_int, powers[level - 1]);
+  ToDecimalChunks(low, powers, level - 1, chunks);
+  ToDecimalChunks(high, powers, level - 1, chunks + count / 2);
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::FromDecimalChunks(const uint64_t* chunks, size_t count,
+                                                                 const std::vector<BasicBigInteger>& powers) {
+  if (count <= kRadixConversionThreshold) {
+    BasicBigInteger big_int;
+    for (size_t i = count; i > 0; --i) {
+      MulSmall(big_int, static_cast<Limb>(kDecimalChunk));
+      AddSmall(big_int, static_cast<Limb>(chunks[i - 1]));
+    }
+    return big_int;
+  }
+
+  size_t level = 0;
+  while ((size_t(2) << level) < count) {
+    ++level;
+  }
+
+  size_t half = size_t(1) << level;
+  BasicBigInteger big_int = multiply(FromDecimalChunks(chunks + half, count - half, powers), powers[level]);
+  big_int += FromDecimalChunks(chunks, half, powers);
+  return big_int;
+}
+
+// Splits the digits in [first, last) into base 10^width chunks, lowest first.
+template <typename Limbs>
+template <typename Chunk>
+void BasicBigInteger<Limbs>::ReadChunks(const char* first, const char* last, size_t width, Chunk* chunks) {
+  for (size_t i = 0; last != first; ++i) {
+    const char* begin = last - std::min(static_cast<size_t>(last - first), width);
+    Chunk chunk = 0;
+    for (const char* pos = begin; pos != last; ++pos) {
+      chunk = chunk * 10 + static_cast<Chunk>(*pos - '0');
+    }
+    chunks[i] = chunk;
+    last = begin;
+  }
+}
+
+// Prints count base 10^width chunks, lowest first, with a nonzero top chunk unless count == 1.
+template <typename Limbs>
+template <typename Chunk>
+std::to_chars_result BasicBigInteger<Limbs>::WriteChunks(char* first, char* last, bool negative, const Chunk* chunks,
+                                                         size_t count, size_t width) {
+  size_t top_digits = 1;
+  for (Chunk value = chunks[count - 1]; value >= 10; value /= 10) {
+    ++top_digits;
+  }
+
+  size_t length = (negative ? 1 : 0) + top_digits + (count - 1) * width;
+  if (static_cast<size_t>(last - first) < length) {
+    return {last, std::errc::value_too_large};
+  }
+
+  char* pos = first + length;
+  for (size_t i = 0; i < count; ++i) {
+    Chunk value = chunks[i];
+    for (size_t j = (i + 1 == count ? top_digits : width); j > 0; --j) {
+      *--pos = static_cast<char>('0' + value % 10);
+      value /= 10;
+    }
+  }
+  if (negative) {
+    *first = '-';
+  }
+
+  return {first + length, std::errc()};
+}
+
+template <typename Limbs>
+std::from_chars_result BasicBigInteger<Limbs>::from_chars(const char* first, const char* last,
+                                                          BasicBigInteger& big_int) {
+  const char* begin = first;
+  bool negative = ((begin != last) && (*begin == '-'));
+  if (negative) {
+    ++begin;
+  }
+
+  const char* end = begin;
+  while ((end != last) && (*end >= '0') && (*end <= '9')) {
+    ++end;
+  }
+  if (end == begin) {
+    return {first, std::errc::invalid_argument};
+  }
+  while ((end - begin > 1) && (*begin == '0')) {
+    ++begin;
+  }
+
+  if constexpr (Limbs::kDecimalDigits != 0) {
+    big_int.number_.resize((static_cast<size_t>(end - begin) + Limbs::kDecimalDigits - 1) / Limbs::kDecimalDigits);
+    ReadChunks(begin, end, Limbs::kDecimalDigits, big_int.number_.data());
+  } else {
+    std::vector<uint64_t> chunks((static_cast<size_t>(end - begin) + kDecimalChunkDigits - 1) / kDecimalChunkDigits);
+    ReadChunks(begin, end, kDecimalChunkDigits, chunks.data());
+
+    size_t levels = 0;
+    while ((size_t(1) << levels) < chunks.size()) {
+      ++levels;
+    }
+    big_int = FromDecimalChunks(chunks.data(), chunks.size(), DecimalPowers(levels));
+  }
+
+  if ((big_int.number_.size() == 1) && (big_int.number_[0] == 0)) {
+    big_int.sign_ = Zero;
+  } else {
+    big_int.sign_ = (negative ? Negative : Positive);
+  }
+
+  return {end, std::errc()};
+}
+
+template <typename Limbs>
+std::to_chars_result BasicBigInteger<Limbs>::to_chars(char* first, char* last, const BasicBigInteger& big_int) {
+  bool negative = (big_int.sign_ == Negative);
+
+  if constexpr (Limbs::kDecimalDigits != 0) {
+    return WriteChunks(first, last, negative, big_int.number_.data(), big_int.number_.size(), Limbs::kDecimalDigits);
+  } else {
+    size_t levels = 0;
+    while ((size_t(1) << levels) * kDecimalChunkDigits < max_chars(big_int)) {
+      ++levels;
+    }
+
+    std::vector<uint64_t> chunks(size_t(1) << levels);
+    ToDecimalChunks(Abs(big_int), DecimalPowers(levels), levels, chunks.data());
+
+    size_t count = chunks.size();
+    while ((count > 1) && (chunks[count - 1] == 0)) {
+      --count;
+    }
+    return WriteChunks(first, last, negative, chunks.data(), count, kDecimalChunkDigits);
+  }
+}
+
+template <typename Limbs>
+size_t BasicBigInteger<Limbs>::max_chars(const BasicBigInteger& big_int) {
+  size_t sign = (big_int.sign_ == Negative ? 1 : 0);
+
+  if constexpr (Limbs::kDecimalDigits != 0) {
+    return sign + big_int.number_.size() * Limbs::kDecimalDigits;
+  } else {
+    // 64 * log10(2) < 19.27 decimal digits per limb.
+    return sign + big_int.number_.size() * 64 * 30103 / 100000 + 1;
+  }
+}
+
+template <typename Limbs>
+void BasicBigInteger<Limbs>::Swap(BasicBigInteger& big_int) {
+  std::swap(number_, big_int.number_);
+  std::swap(sign_, big_int.sign_);
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>::BasicBigInteger(int value) {
+  if (value > 0) {
+    sign_ = Positive;
+    DecToOur(static_cast<uint32_t>(value));
+  } else if (value == 0) {
+    sign_ = Zero;
+    number_.emplace_back(0);
+  } else {
+    sign_ = Negative;
+    DecToOur(static_cast<uint32_t>(-value));
+  }
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>::BasicBigInteger(std::string_view str) : BasicBigInteger() {
+  from_chars(str.data(), str.data() + str.size(), *this);
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>::BasicBigInteger(const BasicBigInteger& big_int) : sign_(big_int.sign_) {
+  number_.resize(big_int.number_.size());
+  std::copy(big_int.number_.begin(), big_int.number_.end(), number_.data());
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>& BasicBigInteger<Limbs>::operator=(BasicBigInteger big_int) {
+  Swap(big_int);
+  return *this;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>::operator bool() const {
+  if (sign_ == Zero) {
+    return false;
+  }
+
+  return true;
+}
+
+template <typename Limbs>
+std::string BasicBigInteger<Limbs>::toString(void) const {
+  std::string str(max_chars(*this), '\0');
+  auto result = to_chars(str.data(), str.data() + str.size(), *this);
+  str.resize(static_cast<size_t>(result.ptr - str.data()));
+  return str;
+}
+
+template <typename Limbs>
+bool BasicBigInteger<Limbs>::operator<(const BasicBigInteger& big_int) const {
+  if (sign_ < big_int.sign_) {
+    return true;
+  }
+
+  if (sign_ > big_int.sign_) {
+    return false;
+  }
+
+  bool my_true = (sign_ == Positive);
+  bool my_false = !my_true;
+
+  if (big_int.number_.size() > number_.size()) {
+    return my_true;
+  }
+
+  if (big_int.number_.size() < number_.size()) {
+    return my_false;
+  }
+
+  for (size_t i = number_.size(); i > 0; --i) {
+    if (big_int.number_[i - 1] > number_[i - 1]) {
+      return my_true;
+    }
+    if (big_int.number_[i - 1] < number_[i - 1]) {
+      return my_false;
+    }
+  }
+
+  return false;
+}
+
+template <typename Limbs>
+bool BasicBigInteger<Limbs>::operator==(const BasicBigInteger& big_int) const {
+  if ((sign_ != big_int.sign_) || (number_.size() != big_int.number_.size())) {
+    return false;
+  }
+
+  for (size_t j = 0; j < number_.size(); ++j) {
+    if (number_[j] != big_int.number_[j]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::operator-() const {
+  BasicBigInteger big_int = *this;
+
+  if (big_int.sign_ == Positive) {
+    big_int.sign_ = Negative;
+  } else if (big_int.sign_ == Negative) {
+    big_int.sign_ = Positive;
+  }
+
+  return big_int;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>& BasicBigInteger<Limbs>::operator+=(const BasicBigInteger& big_int) {
+  AddInPlace(big_int, big_int.sign_);
+  return *this;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>& BasicBigInteger<Limbs>::operator+=(BasicBigInteger&& big_int) {
+  AddInPlace(big_int, big_int.sign_);
+  if (&big_int != this) {
+    Recycle(big_int);
+  }
+  return *this;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::operator+(const BasicBigInteger& big_int) const {
+  BasicBigInteger new_big_int = *this;
+  return std::move(new_big_int += big_int);
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> operator+(int value, const BasicBigInteger<Limbs>& big_int) {
+  return BasicBigInteger<Limbs>(value) + big_int;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>& BasicBigInteger<Limbs>::operator-=(const BasicBigInteger& big_int) {
+  AddInPlace(big_int, static_cast<Sign>(-big_int.sign_));
+  return *this;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>& BasicBigInteger<Limbs>::operator-=(BasicBigInteger&& big_int) {
+  AddInPlace(big_int, static_cast<Sign>(-big_int.sign_));
+  if (&big_int != this) {
+    Recycle(big_int);
+  }
+  return *this;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::operator-(const BasicBigInteger& big_int) const {
+  BasicBigInteger new_big_int = *this;
+  return std::move(new_big_int -= big_int);
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> operator-(int value, const BasicBigInteger<Limbs>& big_int) {
+  return BasicBigInteger<Limbs>(value) - big_int;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>& BasicBigInteger<Limbs>::operator*=(const BasicBigInteger& big_int) {
+  MulInto(*this, big_int, *this);
+  return *this;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::operator*(const BasicBigInteger& big_int) const {
+  if (SpareLimbs().resource() != memory_resource()) {
+    BasicBigInteger new_big_int;
+    MulInto(*this, big_int, new_big_int);
+    return new_big_int;
+  }
+
+  BasicBigInteger new_big_int(std::move(SpareLimbs()));
+  MulInto(*this, big_int, new_big_int);
+  return new_big_int;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> operator*(int value, const BasicBigInteger<Limbs>& big_int) {
+  return BasicBigInteger<Limbs>(value) * big_int;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>& BasicBigInteger<Limbs>::operator/=(const BasicBigInteger& big_int) {
+  return *this = std::move(divmod(*this, big_int).first);
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::operator/(const BasicBigInteger& big_int) const {
+  BasicBigInteger new_big_int = *this;
+  return std::move(new_big_int /= big_int);
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> operator/(int value, const BasicBigInteger<Limbs>& big_int) {
+  return BasicBigInteger<Limbs>(value) / big_int;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>& BasicBigInteger<Limbs>::operator%=(const BasicBigInteger &big_int) {
+  return *this = std::move(divmod(*this, big_int).second);
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::operator%(const BasicBigInteger &big_int) const {
+  BasicBigInteger new_big_int = *this;
+  return new_big_int %= big_int;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> operator%(int value, const BasicBigInteger<Limbs>& big_int) {
+  return BasicBigInteger<Limbs>(value) % big_int;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>& BasicBigInteger<Limbs>::operator++() {
+  return *this += 1;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>& BasicBigInteger<Limbs>::operator--() {
+  return *this -= 1;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::operator++(int) {
+  BasicBigInteger big_int = *this;
+  ++*this;
+  return big_int;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::operator--(int) {
+  BasicBigInteger big_int = *this;
+  --*this;
+  return big_int;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::operator~() const {
+  BasicBigInteger big_int = -*this;
+  return --big_int;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>& BasicBigInteger<Limbs>::operator&=(const BasicBigInteger& big_int) {
+  return *this = Bitwise(*this, big_int, [](uint64_t x, uint64_t y) { return x & y; });
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::operator&(const BasicBigInteger& big_int) const {
+  return Bitwise(*this, big_int, [](uint64_t x, uint64_t y) { return x & y; });
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>& BasicBigInteger<Limbs>::operator|=(const BasicBigInteger& big_int) {
+  return *this = Bitwise(*this, big_int, [](uint64_t x, uint64_t y) { return x | y; });
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::operator|(const BasicBigInteger& big_int) const {
+  return Bitwise(*this, big_int, [](uint64_t x, uint64_t y) { return x | y; });
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs>& BasicBigInteger<Limbs>::operator^=(const BasicBigInteger& big_int) {
+  return *this = Bitwise(*this, big_int, [](uint64_t x, uint64_t y) { return x ^ y; });
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::operator^(const BasicBigInteger& big_int) const {
+  return Bitwise(*this, big_int, [](uint64_t x, uint64_t y) { return x ^ y; });
+}
+
+// Binary limbs move in one pass from the top down; decimal limbs multiply by 2^shift.
+template <typename Limbs>
+BasicBigInteger<Limbs>& BasicBigInteger<Limbs>::operator<<=(size_t shift) {
+  if ((sign_ == Zero) || (shift == 0)) {
+    return *this;
+  }
+
+  if constexpr (Limbs::kDecimalDigits == 0) {
+    size_t words = shift / 64;
+    size_t bits = shift % 64;
+    size_t n = number_.size();
+    number_.resize(n + words + 1);
+
+    for (size_t i = n; i > 0; --i) {
+      Limb high = (bits == 0 ? number_[i] : (number_[i] << bits) | (number_[i - 1] >> (64 - bits)));
+      number_[i + words] = high;
+    }
+    number_[words] = number_[0] << bits;
+    std::fill(number_.begin(), number_.begin() + words, 0);
+  } else if (shift < 30) {
+    MulSmall(*this, Limb(1) << shift);
+  } else {
+    *this *= PowerOfTwo(shift);
+  }
+
+  Normalize(sign_);
+  return *this;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::operator<<(size_t shift) const {
+  BasicBigInteger big_int = *this;
+  return big_int <<= shift;
+}
+
+// Shifts |x| and, for a negative x that lost one bits, moves one further from zero.
+template <typename Limbs>
+BasicBigInteger<Limbs>& BasicBigInteger<Limbs>::operator>>=(size_t shift) {
+  if ((sign_ == Zero) || (shift == 0)) {
+    return *this;
+  }
+
+  Sign sign = sign_;
+  bool lost = false;
+  if constexpr (Limbs::kDecimalDigits == 0) {
+    size_t words = shift / 64;
+    size_t bits = shift % 64;
+    size_t n = number_.size();
+    if (words >= n) {
+      return *this = (sign == Negative ? BasicBigInteger(-1) : BasicBigInteger());
+    }
+
+    for (size_t i = 0; (i < words) && !lost; ++i) {
+      lost = (number_[i] != 0);
+    }
+    lost = lost || ((bits != 0) && ((number_[words] << (64 - bits)) != 0));
+
+    for (size_t i = 0; i + words < n; ++i) {
+      Limb high = ((bits == 0) || (i + words + 1 == n) ? 0 : number_[i + words + 1] << (64 - bits));
+      number_[i] = (number_[i + words] >> bits) | high;
+    }
+    number_.resize(n - words);
+  } else if (shift < 30) {
+    lost = (DivSmall(*this, Limb(1) << shift) != 0);
+  } else {
+    auto [quotient, remainder] = divmod(*this, PowerOfTwo(shift));
+    lost = (remainder.sign_ != Zero);
+    *this = std::move(quotient);
+  }
+
+  Normalize(sign_);
+  if ((sign == Negative) && lost) {
+    AddSmall(*this, 1);
+    sign_ = Negative;
+  }
+  return *this;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::operator>>(size_t shift) const {
+  BasicBigInteger big_int = *this;
+  return big_int >>= shift;
+}
+
+template <typename Limbs>
+size_t BasicBigInteger<Limbs>::bit_length() const {
+  if (sign_ == Zero) {
+    return 0;
+  }
+
+  if constexpr (Limbs::kDecimalDigits == 0) {
+    return 64 * (number_.size() - 1) + static_cast<size_t>(std::bit_width(number_.back()));
+  } else {
+    std::vector<uint64_t> words = BinaryWords(*this);
+    return 64 * (words.size() - 1) + static_cast<size_t>(std::bit_width(words.back()));
+  }
+}
+
+// For x < 0 the bits are those of ~(|x| - 1): zero below the lowest one bit of |x|,
+// one at it and the complement of |x| above it.
+template <typename Limbs>
+bool BasicBigInteger<Limbs>::test_bit(size_t index) const {
+  std::vector<uint64_t> buffer;
+  const uint64_t* words = nullptr;
+  size_t count = 0;
+  if constexpr (Limbs::kDecimalDigits == 0) {
+    words = number_.data();
+    count = (sign_ == Zero ? 0 : number_.size());
+  } else {
+    buffer = BinaryWords(*this);
+    words = buffer.data();
+    count = buffer.size();
+  }
+
+  auto bit = [&](size_t i) { return (i / 64 < count) && (((words[i / 64] >> (i % 64)) & 1) != 0); };
+  if (sign_ != Negative) {
+    return bit(index);
+  }
+
+  size_t lowest = 0;
+  while (words[lowest] == 0) {
+    ++lowest;
+  }
+  lowest = 64 * lowest + static_cast<size_t>(std::countr_zero(words[lowest]));
+  return (index < lowest ? false : index == lowest ? true : !bit(index));
+}
+
+template <typename Limbs>
+size_t BasicBigInteger<Limbs>::popcount() const {
+  if (sign_ == Negative) {
+    return std::numeric_limits<size_t>::max();
+  }
+
+  size_t count = 0;
+  for (uint64_t word : BinaryWords(*this)) {
+    count += static_cast<size_t>(std::popcount(word));
+  }
+  return count;
+}
+
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicBigInteger<Limbs>::multiply(const BasicBigInteger& big_int1, const BasicBigInteger& big_int2,
+                                                        Algorithm algorithm) {
+  if ((big_int1.sign_ == Zero) || (big_int2.sign_ == Zero)) {
+    return BasicBigInteger();
+  }
+
+  BasicBigInteger new_big_int = Multi(big_int1, big_int2, algorithm);
+  new_big_int.sign_ = (big_int1.sign_ == big_int2.sign_ ? Positive : Negative);
+  return new_big_int;
+}
+
+template <typename Limbs>
+void BasicBigInteger<Limbs>::multiply_batch(std::span<const BasicBigInteger> big_ints1,
+                                            std::span<const BasicBigInteger> big_ints2,
+                                            std::span<BasicBigInteger> result) {
+  size_t count = std::min({big_ints1.size(), big_ints2.size(), result.size()});
+
+  // Binary limbs have no vector multiply wide enough, so there every pair goes alone.
+  std::vector<size_t> grouped;
+  std::vector<size_t> single;
+  size_t work = 0;
+  for (size_t i = 0; i < count; ++i) {
+    size_t n = big_ints1[i].number_.size();
+    size_t m = big_ints2[i].number_.size();
+    work += std::min(n, m);
+    if ((Limbs::kDecimalDigits != 0) && !big_ints1[i].IsZero() && !big_ints2[i].IsZero() &&
+        (std::max(n, m) <= kBatchLimbs)) {
+      grouped.push_back(i);
+    } else {
+      single.push_back(i);
+    }
+  }
+
+  // Pairs of equal sizes share a group, so that little zero padding gets multiplied.
+  std::sort(grouped.begin(), grouped.end(), [&](size_t i, size_t j) {
+    return std::make_pair(big_ints1[i].number_.size(), big_ints2[i].number_.size()) <
+           std::make_pair(big_ints1[j].number_.size(), big_ints2[j].number_.size());
+  });
+
+  size_t groups = (grouped.size() + kBatchLanes - 1) / kBatchLanes;
+  ForEachRange(groups + single.size(), work, [&](size_t begin, size_t end) {
+    std::vector<uint64_t> packed;
+    for (size_t item = begin; item < end; ++item) {
+      if (item < groups) {
+        size_t first = item * kBatchLanes;
+        MulBatchGroup(grouped.data() + first, std::min(kBatchLanes, grouped.size() - first), big_ints1, big_ints2,
+                      result, packed);
+      } else {
+        size_t i = single[item - groups];
+        MulInto(big_ints1[i], big_ints2[i], result[i]);
+      }
+    }
+  });
+}
+
+template <typename Limbs>
+void BasicBigInteger<Limbs>::add_batch(std::span<const BasicBigInteger> big_ints1,
+                                       std::span<const BasicBigInteger> big_ints2, std::span<BasicBigInteger> result) {
+  size_t count = std::min({big_ints1.size(), big_ints2.size(), result.size()});
+  size_t work = 0;
+  for (size_t i = 0; i < count; ++i) {
+    work += std::max(big_ints1[i].number_.size(), big_ints2[i].number_.size());
+  }
+
+  // Sums are linear: AddCarry already vectorizes within each operand.
+  ForEachRange(count, work, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      if (&result[i] == &big_ints2[i]) {
+        result[i].AddInPlace(big_ints1[i], big_ints1[i].sign_);
+        continue;
+      }
+      if (&result[i] != &big_ints1[i]) {
+        result[i].number_ = big_ints1[i].number_;
+        result[i].sign_ = big_ints1[i].sign_;
+      }
+      result[i].AddInPlace(big_ints2[i], big_ints2[i].sign_);
+    }
+  });
+}
+
+template <typename Limbs>
+void BasicBigInteger<Limbs>::powmod_batch(std::span<const BasicBigInteger> bases,
+                                          std::span<const BasicBigInteger> exponents, const BasicBigInteger& modulus,
+                                          std::span<BasicBigInteger> result) {
+  BasicModContext<Limbs>(modulus).pow_batch(bases, exponents, result);
+}
+
+// Packs the lanes, multiplies them side by side and unpacks. Sizes and signs are read before
+// any result is written, so that a result may be one of its own pair's operands.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::MulBatchGroup(const size_t* indices, size_t lanes,
+                                           std::span<const BasicBigInteger> big_ints1,
+                                           std::span<const BasicBigInteger> big_ints2,
+                                           std::span<BasicBigInteger> result, std::vector<uint64_t>& packed) {
+  size_t n = 0;
+  size_t m = 0;
+  for (size_t lane = 0; lane < lanes; ++lane) {
+    n = std::max(n, big_ints1[indices[lane]].number_.size());
+    m = std::max(m, big_ints2[indices[lane]].number_.size());
+  }
+
+  packed.assign(2 * (n + m) * kBatchLanes, 0);
+  uint64_t* a = packed.data();
+  uint64_t* b = a + n * kBatchLanes;
+  uint64_t* out = b + m * kBatchLanes;
+
+  size_t sizes[kBatchLanes];
+  Sign signs[kBatchLanes];
+  for (size_t lane = 0; lane < lanes; ++lane) {
+    const BasicBigInteger& big_int1 = big_ints1[indices[lane]];
+    const BasicBigInteger& big_int2 = big_ints2[indices[lane]];
+    for (size_t i = 0; i < big_int1.number_.size(); ++i) {
+      a[i * kBatchLanes + lane] = big_int1.number_[i];
+    }
+    for (size_t j = 0; j < big_int2.number_.size(); ++j) {
+      b[j * kBatchLanes + lane] = big_int2.number_[j];
+    }
+    sizes[lane] = big_int1.number_.size() + big_int2.number_.size();
+    signs[lane] = (big_int1.sign_ == big_int2.sign_ ? Positive : Negative);
+  }
+
+  MulBatchLanes(a, n, b, m, out);
+
+  for (size_t lane = 0; lane < lanes; ++lane) {
+    BasicBigInteger& target = result[indices[lane]];
+    target.number_.resize(sizes[lane]);
+    for (size_t i = 0; i < sizes[lane]; ++i) {
+      target.number_[i] = static_cast<Limb>(out[i * kBatchLanes + lane]);
+    }
+    target.Normalize(signs[lane]);
+  }
+}
+
+// Product scanning: column sums of up to kBatchFold products stay below 2^64, and their
+// 32-bit halves are summed separately until FoldBatchColumn converts them to base 10^9.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::MulBatchLanes(const uint64_t* a, size_t n, const uint64_t* b, size_t m,
+                                           uint64_t* out) {
+#ifdef BIGINTEGER_X86_SIMD
+  if (HasAvx2()) {
+    MulBatchLanesAvx2(a, n, b, m, out);
+    return;
+  }
+#endif
+
+  uint64_t carry[kBatchLanes] = {};
+  for (size_t column = 0; column + 1 < n + m; ++column) {
+    size_t first = (column >= m ? column - m + 1 : 0);
+    size_t last = std::min(column + 1, n);
+    uint64_t low[kBatchLanes] = {};
+    uint64_t high[kBatchLanes] = {};
+
+    for (size_t i = first; i < last; i += kBatchFold) {
+      uint64_t sum[kBatchLanes] = {};
+      for (size_t k = i; k < std::min(i + kBatchFold, last); ++k) {
+        for (size_t lane = 0; lane < kBatchLanes; ++lane) {
+          sum[lane] += a[k * kBatchLanes + lane] * b[(column - k) * kBatchLanes + lane];
+        }
+      }
+      for (size_t lane = 0; lane < kBatchLanes; ++lane) {
+        low[lane] += sum[lane] & 0xffffffff;
+        high[lane] += sum[lane] >> 32;
+      }
+    }
+
+    FoldBatchColumn(low, high, carry, out + column * kBatchLanes);
+  }
+
+  std::copy(carry, carry + kBatchLanes, out + (n + m - 1) * kBatchLanes);
+}
+
+// out = (high * 2^32 + low + carry) mod 10^9 and carry = the quotient, per lane. high is split
+// by 10^9 first so that everything stays within 64 bits.
+template <typename Limbs>
+void BasicBigInteger<Limbs>::FoldBatchColumn(const uint64_t* low, const uint64_t* high, uint64_t* carry,
+                                             uint64_t* out) {
+  for (size_t lane = 0; lane < kBatchLanes; ++lane) {
+    uint64_t high_quotient = high[lane] / kRang;
+    uint64_t value = ((high[lane] % kRang) << 32) + low[lane] + carry[lane];
+    out[lane] = value % kRang;
+    carry[lane] = (high_quotient << 32) + value / kRang;
+  }
+}
+
+#ifdef BIGINTEGER_X86_SIMD
+template <typename Limbs>
+void BasicBigInteger<Limbs>::MulBatchLanesAvx2(const uint64_t* a, size_t n, const uint64_t* b, size_t m,
+                                               uint64_t* out) {
+  const __m256i mask = _mm256_set1_epi64x(0xffffffff);
+
+  alignas(32) uint64_t carry[kBatchLanes] = {};
+  for (size_t column = 0; column + 1 < n + m; ++column) {
+    size_t first = (column >= m ? column - m + 1 : 0);
+    size_t last = std::min(column + 1, n);
+    __m256i low = _mm256_setzero_si256();
+    __m256i high = _mm256_setzero_si256();
+
+    for (size_t i = first; i < last; i += kBatchFold) {
+      __m256i sum = _mm256_setzero_si256();
+      for (size_t k = i; k < std::min(i + kBatchFold, last); ++k) {
+        __m256i limb1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + k * kBatchLanes));
+        __m256i limb2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + (column - k) * kBatchLanes));
+        sum = _mm256_add_epi64(sum, _mm256_mul_epu32(limb1, limb2));
+      }
+      low = _mm256_add_epi64(low, _mm256_and_si256(sum, mask));
+      high = _mm256_add_epi64(high, _mm256_srli_epi64(sum, 32));
+    }
+
+    alignas(32) uint64_t lows[kBatchLanes];
+    alignas(32) uint64_t highs[kBatchLanes];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lows), low);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(highs), high);
+    FoldBatchColumn(lows, highs, carry, out + column * kBatchLanes);
+  }
+
+  std::copy(carry, carry + kBatchLanes, out + (n + m - 1) * kBatchLanes);
+}
+#endif
+
+template <typename Limbs>
+std::pair<BasicBigInteger<Limbs>, BasicBigInteger<Limbs>> BasicBigInteger<Limbs>::divmod(
+    const BasicBigInteger& big_int1, const BasicBigInteger& big_int2) {
+  BasicBigInteger quotient;
+  BasicBigInteger remainder;
+  DivModAbs(big_int1, big_int2, quotient, remainder);
+
+  if (quotient.sign_ != Zero) {
+    quotient.sign_ = (big_int1.sign_ == big_int2.sign_ ? Positive : Negative);
+  }
+  if (remainder.sign_ != Zero) {
+    remainder.sign_ = big_int1.sign_;
+  }
+
+  return {std::move(quotient), std::move(remainder)};
+}
+
+template <typename Limbs, size_t N>
+constexpr BasicStaticBigInteger<Limbs, N>::BasicStaticBigInteger(int value) {
+  uint64_t magnitude = (value < 0 ? uint64_t(0) - static_cast<uint64_t>(value) : static_cast<uint64_t>(value));
+  while (magnitude != 0) {
+    if (size_ == N) {
+      NotRepresentable();
+      *this = BasicStaticBigInteger();
+      return;
+    }
+    limbs_[size_++] = static_cast<Limb>(magnitude % kRang);
+    magnitude = static_cast<uint64_t>(magnitude / kRang);
+  }
+  Normalize(value < 0 ? -1 : 1);
+}
+
+template <typename Limbs, size_t N>
+constexpr BasicStaticBigInteger<Limbs, N>::BasicStaticBigInteger(std::string_view str) {
+  bool negative = (!str.empty() && (str[0] == '-'));
+  str.remove_prefix(negative ? 1 : 0);
+  Limb base = 10;
+  if ((str.size() > 2) && (str[0] == '0') && ((str[1] == 'x') || (str[1] == 'X'))) {
+    base = 16;
+    str.remove_prefix(2);
+  }
+
+  for (char symbol : str) {
+    Limb digit = base;
+    if ((symbol >= '0') && (symbol <= '9')) {
+      digit = static_cast<Limb>(symbol - '0');
+    } else if ((symbol >= 'a') && (symbol <= 'f')) {
+      digit = static_cast<Limb>(symbol - 'a' + 10);
+    } else if ((symbol >= 'A') && (symbol <= 'F')) {
+      digit = static_cast<Limb>(symbol - 'A' + 10);
+    } else if (symbol == '\'') {
+      continue;
+    }
+
+    if (digit >= base) {
+      NotRepresentable();
+      *this = BasicStaticBigInteger();
+      return;
+    }
+    MulAdd(base, digit);
+  }
+  Normalize(negative ? -1 : 1);
+}
+
+template <typename Limbs, size_t N>
+template <size_t M>
+constexpr BasicStaticBigInteger<Limbs, N>::BasicStaticBigInteger(const BasicStaticBigInteger<Limbs, M>& value) {
+  if (value.size_ > N) {
+    NotRepresentable();
+    return;
+  }
+  std::copy(value.limbs_, value.limbs_ + value.size_, limbs_);
+  size_ = value.size_;
+  sign_ = value.sign_;
+}
+
+template <typename Limbs, size_t N>
+BasicStaticBigInteger<Limbs, N>::operator BasicBigInteger<Limbs>() const {
+  BigInt big_int = BigInt::FromLimbs(limbs_, size_);
+  if (sign_ < 0) {
+    big_int.sign_ = BigInt::Negative;
+  }
+  return big_int;
+}
+
+template <typename Limbs, size_t N>
+template <size_t M>
+constexpr bool BasicStaticBigInteger<Limbs, N>::operator==(const BasicStaticBigInteger<Limbs, M>& value) const {
+  return (*this <=> value) == 0;
+}
+
+template <typename Limbs, size_t N>
+template <size_t M>
+constexpr std::strong_ordering BasicStaticBigInteger<Limbs, N>::operator<=>(
+    const BasicStaticBigInteger<Limbs, M>& value) const {
+  if (sign_ != value.sign_) {
+    return sign_ <=> value.sign_;
+  }
+  return BigInt::CompareLimbs(limbs_, size_, value.limbs_, value.size_) * sign_ <=> 0;
+}
+
+template <typename Limbs, size_t N>
+constexpr BasicStaticBigInteger<Limbs, N> BasicStaticBigInteger<Limbs, N>::operator-() const {
+  BasicStaticBigInteger value = *this;
+  value.sign_ = -sign_;
+  return value;
+}
+
+template <typename Limbs, size_t N>
+template <size_t M>
+constexpr auto BasicStaticBigInteger<Limbs, N>::operator+(const BasicStaticBigInteger<Limbs, M>& value) const {
+  BasicStaticBigInteger<Limbs, std::max(N, M) + 1> result;
+  result.Combine(*this, value, value.sign_);
+  return result;
+}
+
+template <typename Limbs, size_t N>
+template <size_t M>
+constexpr auto BasicStaticBigInteger<Limbs, N>::operator-(const BasicStaticBigInteger<Limbs, M>& value) const {
+  BasicStaticBigInteger<Limbs, std::max(N, M) + 1> result;
+  result.Combine(*this, value, -value.sign_);
+  return result;
+}
+
+template <typename Limbs, size_t N>
+template <size_t M>
+constexpr BasicStaticBigInteger<Limbs, N + M> BasicStaticBigInteger<Limbs, N>::operator*(
+    const BasicStaticBigInteger<Limbs, M>& value) const {
+  BasicStaticBigInteger<Limbs, N + M> result;
+  if ((sign_ != 0) && (value.sign_ != 0)) {
+    BigInt::MulSchoolbook(limbs_, size_, value.limbs_, value.size_, result.limbs_);
+    result.size_ = size_ + value.size_;
+    result.Normalize(sign_ * value.sign_);
+  }
+  return result;
+}
+
+template <typename Limbs, size_t N>
+template <size_t M>
+constexpr BasicStaticBigInteger<Limbs, N> BasicStaticBigInteger<Limbs, N>::operator/(
+    const BasicStaticBigInteger<Limbs, M>& value) const {
+  BasicStaticBigInteger quotient;
+  BasicStaticBigInteger<Limbs, M> remainder;
+  DivMod(*this, value, quotient, remainder);
+  return quotient;
+}
+
+template <typename Limbs, size_t N>
+template <size_t M>
+constexpr BasicStaticBigInteger<Limbs, M> BasicStaticBigInteger<Limbs, N>::operator%(
+    const BasicStaticBigInteger<Limbs, M>& value) const {
+  BasicStaticBigInteger quotient;
+  BasicStaticBigInteger<Limbs, M> remainder;
+  DivMod(*this, value, quotient, remainder);
+  return remainder;
+}
+
+// Drops leading zero limbs; sign applies unless nothing is left.
+template <typename Limbs, size_t N>
+constexpr void BasicStaticBigInteger<Limbs, N>::Normalize(int sign) {
+  while ((size_ > 0) && (limbs_[size_ - 1] == 0)) {
+    --size_;
+  }
+  sign_ = (size_ == 0 ? 0 : sign);
+}
+
+// |*this| = |*this| * factor + addend.
+template <typename Limbs, size_t N>
+constexpr void BasicStaticBigInteger<Limbs, N>::MulAdd(Limb factor, Limb addend) {
+  DoubleLimb old_tmp = addend;
+  for (size_t i = 0; i < size_; ++i) {
+    DoubleLimb value = static_cast<DoubleLimb>(limbs_[i]) * factor + old_tmp;
+    limbs_[i] = static_cast<Limb>(value % kRang);
+    old_tmp = value / kRang;
+  }
+
+  if (old_tmp != 0) {
+    if (size_ == N) {
+      NotRepresentable();
+      *this = BasicStaticBigInteger();
+      return;
+    }
+    limbs_[size_++] = static_cast<Limb>(old_tmp);
+  }
+}
+
+// *this = big_int1 + sign * |big_int2|, for a *this wide enough to hold any such sum.
+template <typename Limbs, size_t N>
+template <size_t A, size_t B>
+constexpr void BasicStaticBigInteger<Limbs, N>::Combine(const BasicStaticBigInteger<Limbs, A>& big_int1,
+                                                        const BasicStaticBigInteger<Limbs, B>& big_int2, int sign) {
+  if (sign == 0) {
+    *this = BasicStaticBigInteger(big_int1);
+    return;
+  }
+  if (big_int1.sign_ == 0) {
+    *this = BasicStaticBigInteger(big_int2);
+    sign_ = sign;
+    return;
+  }
+
+  if (big_int1.sign_ == sign) {
+    size_ = BigInt::AddLimbs(big_int1.limbs_, big_int1.size_, big_int2.limbs_, big_int2.size_, limbs_);
+    sign_ = sign;
+    return;
+  }
+
+  if (BigInt::CompareLimbs(big_int1.limbs_, big_int1.size_, big_int2.limbs_, big_int2.size_) >= 0) {
+    *this = BasicStaticBigInteger(big_int1);
+    BigInt::SubLimbsInPlace(limbs_, size_, big_int2.limbs_, big_int2.size_);
+    Normalize(big_int1.sign_);
+  } else {
+    *this = BasicStaticBigInteger(big_int2);
+    BigInt::SubLimbsInPlace(limbs_, size_, big_int1.limbs_, big_int1.size_);
+    Normalize(sign);
+  }
+}
+
+template <typename Limbs, size_t N>
+template <size_t M>
+constexpr void BasicStaticBigInteger<Limbs, N>::DivMod(const BasicStaticBigInteger& big_int1,
+                                                       const BasicStaticBigInteger<Limbs, M>& big_int2,
+                                                       BasicStaticBigInteger& quotient,
+                                                       BasicStaticBigInteger<Limbs, M>& remainder) {
+  if (big_int2.sign_ == 0) {
+    NotRepresentable();
+    return;
+  }
+  if (BigInt::CompareLimbs(big_int1.limbs_, big_int1.size_, big_int2.limbs_, big_int2.size_) < 0) {
+    remainder = BasicStaticBigInteger<Limbs, M>(big_int1);
+    return;
+  }
+
+  size_t n = big_int1.size_;
+  size_t m = big_int2.size_;
+  if (m == 1) {
+    DoubleLimb rest = 0;
+    for (size_t i = n; i > 0; --i) {
+      DoubleLimb cur = rest * kRang + big_int1.limbs_[i - 1];
+      quotient.limbs_[i - 1] = static_cast<Limb>(cur / big_int2.limbs_[0]);
+      rest = cur % big_int2.limbs_[0];
+    }
+    remainder.limbs_[0] = static_cast<Limb>(rest);
+  } else {
+    Limb work[N + M + 1]{};
+    BigInt::DivKnuth(big_int1.limbs_, n, big_int2.limbs_, m, quotient.limbs_, remainder.limbs_, work);
+  }
+
+  quotient.size_ = n;
+  quotient.Normalize(big_int1.sign_ * big_int2.sign_);
+  remainder.size_ = m;
+  remainder.Normalize(big_int1.sign_);
+}
+
+// The digits are parsed at compile time.
+template <char... kChars>
+constexpr StaticBigInteger<LiteralLimbs<BigInteger::Backend>(sizeof...(kChars))> operator""_sbi() {
+  constexpr char kDigits[] = {kChars...};
+  return StaticBigInteger<LiteralLimbs<BigInteger::Backend>(sizeof...(kChars))>(
+      std::string_view(kDigits, sizeof...(kChars)));
+}
+
+// Folded at compile time as well; at run time the literal only copies its limbs.
+template <char... kChars>
+BigInteger operator""_bi() {
+  static constexpr auto kValue = operator""_sbi<kChars...>();
+  return kValue;
+}
+
+template <typename Limbs>
+std::ostream& operator<<(std::ostream& out, const BasicBigInteger<Limbs>& big_int) {
+  out << big_int.toString();
+  return out;
+}
+
+template <typename Limbs>
+std::istream& operator>>(std::istream& in, BasicBigInteger<Limbs>& big_int) {
+  std::string str;
+  in >> str;
+  BasicBigInteger<Limbs>::from_chars(str.data(), str.data() + str.size(), big_int);
+  return in;
+}
 
-  while ((!new_big_int.number_.empty()) && (new_big_int.number_.back() == 0)) {
-    new_big_int.number_.pop_back();
-  }
+template <typename Limbs>
+BasicBigInteger<Limbs> gcd(const BasicBigInteger<Limbs>& big_int1, const BasicBigInteger<Limbs>& big_int2) {
+  return BasicBigInteger<Limbs>::GcdLehmer(big_int1, big_int2, nullptr);
+}
 
-  if (new_big_int.number_.empty()) {
-    new_big_int.number_.push_back(0);
-    new_big_int.sign_ = Zero;
+// Non-negative; zero when either argument is zero.
+template <typename Limbs>
+BasicBigInteger<Limbs> lcm(const BasicBigInteger<Limbs>& big_int1, const BasicBigInteger<Limbs>& big_int2) {
+  if (big_int1.IsZero() || big_int2.IsZero()) {
+    return BasicBigInteger<Limbs>();
   }
 
-  return std::move(new_big_int);
+  BasicBigInteger<Limbs> result = big_int1 / gcd(big_int1, big_int2);
+  result *= big_int2;
+  result.sign_ = BasicBigInteger<Limbs>::Positive;
+  return result;
 }
 
-BigInteger BigInteger::Multi(const BigInteger& big_int1, const BigInteger& big_int2) const {
-  BigInteger new_big_int;
-  new_big_int.number_.clear();
-
-  uint64_t old_tmp = 0;
-  new_big_int.number_.resize(big_int1.number_.size() + big_int2.number_.size());
+// {g, x, y} with big_int1 * x + big_int2 * y = g = gcd(big_int1, big_int2).
+template <typename Limbs>
+std::tuple<BasicBigInteger<Limbs>, BasicBigInteger<Limbs>, BasicBigInteger<Limbs>> xgcd(
+    const BasicBigInteger<Limbs>& big_int1, const BasicBigInteger<Limbs>& big_int2) {
+  using BigInt = BasicBigInteger<Limbs>;
 
-  for (size_t i = 0; i < big_int1.number_.size(); ++i) {
-    for (size_t j = 0; j < big_int2.number_.size(); ++j) {
-      uint64_t value = static_cast<uint64_t>(big_int1.number_[i]) * static_cast<uint64_t>(big_int2.number_[j])
-                       + old_tmp + new_big_int.number_[i + j];
-      new_big_int.number_[i + j] = static_cast<uint32_t>(value % kRang);
-      old_tmp = value / kRang;
-    }
+  bool swapped = (BigInt::CompareAbs(big_int1, big_int2) < 0);
+  const BigInt& larger = (swapped ? big_int2 : big_int1);
+  const BigInt& smaller = (swapped ? big_int1 : big_int2);
 
-    if (old_tmp != 0) {
-      size_t cur = i + big_int2.number_.size();
-      new_big_int.number_[cur] += static_cast<uint32_t>(old_tmp);
-      old_tmp = 0;
-    }
+  BigInt x;
+  BigInt result = BigInt::GcdLehmer(larger, smaller, &x);
+  if (larger.sign_ == BigInt::Negative) {
+    x = -x;
   }
 
-  while ((!new_big_int.number_.empty()) && (new_big_int.number_.back() == 0)) {
-    new_big_int.number_.pop_back();
+  BigInt y;
+  if (!smaller.IsZero()) {
+    y = result - larger * x;
+    y /= smaller;
   }
 
-  return std::move(new_big_int);
+  if (swapped) {
+    return {result, y, x};
+  }
+  return {result, x, y};
 }
 
-BigInteger BigInteger::Division(const BigInteger& big_int1, const BigInteger& big_int2) const {
-  BigInteger result;
-  BigInteger cur;
-
-  for (size_t i = big_int1.number_.size(); i > 0; --i) {
-    BigInteger cur_step = kRang;
-    cur *= kRang;
-    cur += big_int1.number_[i - 1];
-
-    while ((cur < big_int2) && (i > 1)) {
-      cur_step *= kRang;
-      cur *= kRang;
-      --i;
-      cur += big_int1.number_[i - 1];
-    }
+// GMP-style fused operations: they evaluate into an existing BigInteger, reusing its buffer,
+// and never build the product as a separate BigInteger. Every argument may alias the destination.
 
-    if ((i == 1) && (cur < big_int2)) {
-      result *= cur_step;
-      break;
-    }
+// result = big_int1 * big_int2.
+template <typename Limbs>
+void mul(BasicBigInteger<Limbs>& result, const BasicBigInteger<Limbs>& big_int1, const BasicBigInteger<Limbs>& big_int2) {
+  BasicBigInteger<Limbs>::MulInto(big_int1, big_int2, result);
+}
 
-    BigInteger right = cur;
-    BigInteger left = 1;
-    BigInteger ans;
+// acc += big_int1 * big_int2.
+template <typename Limbs>
+void addmul(BasicBigInteger<Limbs>& acc, const BasicBigInteger<Limbs>& big_int1,
+            const BasicBigInteger<Limbs>& big_int2) {
+  acc.AddMulInPlace(big_int1, big_int2, BasicBigInteger<Limbs>::Positive);
+}
 
-    while (right - left != 1) {
-      BigInteger tmp = left + right;
-      BigInteger average = tmp.number_[0] / 2;
-      BigInteger step = 500000000;
+// acc -= big_int1 * big_int2.
+template <typename Limbs>
+void submul(BasicBigInteger<Limbs>& acc, const BasicBigInteger<Limbs>& big_int1,
+            const BasicBigInteger<Limbs>& big_int2) {
+  acc.AddMulInPlace(big_int1, big_int2, BasicBigInteger<Limbs>::Negative);
+}
 
-      for (size_t i = 1; i < tmp.number_.size(); ++i) {
-        average += step * tmp.number_[i];
-        step *= kRang;
-      }
+// Arithmetic modulo a fixed positive modulus with the per-modulus work done once.
+// Odd moduli coprime to the limb base use Montgomery reduction, any other modulus
+// uses Barrett reduction; both keep residues as fixed-width limb arrays.
+template <typename Limbs>
+class BasicModContext {
+  friend bool is_probable_prime<>(const BasicBigInteger<Limbs>& big_int, size_t rounds);
+
+  using BigInt = BasicBigInteger<Limbs>;
+  using Limb = typename BigInt::Limb;
+  using DoubleLimb = typename BigInt::DoubleLimb;
+  static constexpr DoubleLimb kRang = BigInt::kRang;
+
+  // Modulus limb count from which Montgomery reduction is done with two more products
+  // instead of the limb-by-limb loop.
+  static constexpr size_t kProductReduceThreshold = 400;
+
+  BigInt modulus_;
+  size_t size_;
+  bool montgomery_;
+  // -modulus^-1 mod kRang; from kProductReduceThreshold limbs on also -modulus^-1 mod R.
+  Limb inverse_ = 0;
+  std::vector<Limb> inverse_limbs_;
+  std::vector<Limb> modulus_limbs_;
+  // Montgomery: R^2 mod modulus with R = kRang^size_; Barrett: (kRang^(2 size_) - 1) / modulus.
+  std::vector<Limb> factor_;
+  // The residue 1 in the working representation.
+  std::vector<Limb> one_;
+
+  static Limb NegInverse(Limb value);
+  std::vector<Limb> Pad(const BigInt& big_int) const;
+  void Reduce(Limb* product, Limb* out) const;
+  void Multiply(const Limb* a, const Limb* b, Limb* out) const;
+  std::vector<Limb> ToForm(const BigInt& big_int) const;
+  BigInt FromForm(const std::vector<Limb>& value) const;
+  std::vector<Limb> Pow(const std::vector<Limb>& base, const std::vector<uint64_t>& exponent) const;
+  bool MillerRabin(size_t rounds) const;
 
-      BigInteger value = big_int2 * average;
-      if (value > cur) {
-        right = average;
-      } else if (value < cur) {
-        left = average;
-      } else {
-        ans = average;
-        break;
-      }
-    }
+public:
+  // modulus must be positive.
+  explicit BasicModContext(const BigInt& modulus);
+
+  const BigInt& modulus() const { return modulus_; }
+
+  // The representative of big_int in [0, modulus).
+  BigInt reduce(const BigInt& big_int) const;
+  BigInt multiply(const BigInt& big_int1, const BigInt& big_int2) const;
+  // A negative exponent raises the inverse; zero when there is none.
+  BigInt pow(const BigInt& base, const BigInt& exponent) const;
+  // Zero when big_int shares a factor with the modulus.
+  BigInt inverse(const BigInt& big_int) const;
+
+  // Element-wise multiply and pow over spans, as BasicBigInteger::multiply_batch. The products
+  // come from multiply_batch and are reduced one by one, split over the pool when it is set.
+  void multiply_batch(std::span<const BigInt> big_ints1, std::span<const BigInt> big_ints2,
+                      std::span<BigInt> result) const;
+  void pow_batch(std::span<const BigInt> bases, std::span<const BigInt> exponents, std::span<BigInt> result) const;
+};
 
-    if (right - left == 1) {
-      ans = left;
+#ifdef BIGINTEGER_BINARY_LIMBS
+using ModContext = BasicModContext<BinaryLimbs>;
+#else
+using ModContext = BasicModContext<DecimalLimbs>;
+#endif
+
+// Newton's iteration x = x (2 - value x) doubles the number of correct low digits,
+// starting from the inverse modulo 10 (decimal) or 2 (binary).
+template <typename Limbs>
+typename BasicModContext<Limbs>::Limb BasicModContext<Limbs>::NegInverse(Limb value) {
+  DoubleLimb x = 1;
+  if constexpr (Limbs::kDecimalDigits != 0) {
+    while (x * value % 10 != 1) {
+      ++x;
     }
-
-    result *= kRang;
-    result += ans;
-    cur -= ans * big_int2;
   }
 
-  return std::move(result);
-}
+  for (int i = 0; i < 7; ++i) {
+    DoubleLimb product = static_cast<Limb>(value * x % kRang);
+    x = x * ((2 + kRang - product) % kRang) % kRang;
+  }
 
-void BigInteger::Swap(BigInteger& big_int) {
-  std::swap(number_, big_int.number_);
-  std::swap(sign_, big_int.sign_);
+  return static_cast<Limb>((kRang - x) % kRang);
 }
 
-BigInteger::BigInteger(int value) {
-  if (value > 0) {
-    sign_ = Positive;
-    DecToOur(static_cast<uint32_t>(value));
-  } else if (value == 0) {
-    sign_ = Zero;
-    number_.emplace_back(0);
+template <typename Limbs>
+BasicModContext<Limbs>::BasicModContext(const BigInt& modulus)
+    : modulus_(modulus), size_(modulus.number_.size()), modulus_limbs_(modulus.number_.begin(), modulus.number_.end()) {
+  Limb low = modulus_limbs_[0];
+  if constexpr (Limbs::kDecimalDigits == 0) {
+    montgomery_ = (low % 2 == 1);
   } else {
-    sign_ = Negative;
-    DecToOur(static_cast<uint32_t>(-value));
+    montgomery_ = (low % 2 == 1) && (low % 5 != 0);
   }
-}
-
-BigInteger::BigInteger(const std::string& str) {
-  size_t tmp = 0;
 
-  if (str[0] == '-') {
-    sign_ = Negative;
-    while (str.size() - tmp >= 9) {
-      number_.push_back(static_cast<uint32_t>(std::stoi(str.substr(str.size() - tmp - 9, 9))));
-      tmp += 9;
-    }
-    if (str.size() - tmp > 1) {
-      number_.push_back(static_cast<uint32_t>(std::stoi(str.substr(1, str.size() - tmp - 1))));
+  BigInt power = 1;
+  BigInt::ShiftLimbs(power, size_);
+  if (montgomery_) {
+    inverse_ = NegInverse(low);
+    if (size_ >= kProductReduceThreshold) {
+      BigInt inverse = std::get<1>(xgcd(modulus_, power));
+      inverse_limbs_ = Pad(inverse.sign_ == BigInt::Positive ? power - inverse : -inverse);
     }
-  } else if (str[0] == '0') {
-    sign_ = Zero;
-    number_.emplace_back(0);
+    one_ = Pad(power % modulus_);
+    BigInt::ShiftLimbs(power, size_);
+    factor_ = Pad(power % modulus_);
   } else {
-    sign_ = Positive;
-    while (str.size() - tmp >= 9) {
-      number_.push_back(static_cast<uint32_t>(std::stoi(str.substr(str.size() - tmp - 9, 9))));
-      tmp += 9;
-    }
-    if (str.size() - tmp > 0) {
-      number_.push_back(static_cast<uint32_t>(std::stoi(str.substr(0, str.size() - tmp))));
-    }
+    // (kRang^(2 size_) - 1) / modulus always fits in size_ + 1 limbs.
+    one_ = Pad(1);
+    BigInt::ShiftLimbs(power, size_);
+    BigInt mu = (power - 1) / modulus_;
+    factor_.assign(mu.number_.begin(), mu.number_.end());
+    factor_.resize(size_ + 1, 0);
   }
 }
 
-BigInteger::BigInteger(const BigInteger& big_int) : sign_(big_int.sign_) {
-  number_.resize(big_int.number_.size());
-  std::copy(big_int.number_.begin(), big_int.number_.end(), number_.data());
-}
-
-BigInteger& BigInteger::operator=(BigInteger big_int) {
-  Swap(big_int);
-  return *this;
-}
-
-BigInteger::operator bool() const {
-  if (sign_ == Zero) {
-    return false;
+template <typename Limbs>
+std::vector<typename BasicModContext<Limbs>::Limb> BasicModContext<Limbs>::Pad(const BigInt& big_int) const {
+  std::vector<Limb> limbs(size_, 0);
+  if (big_int.sign_ != BigInt::Zero) {
+    std::copy(big_int.number_.begin(), big_int.number_.end(), limbs.begin());
   }
-
-  return true;
+  return limbs;
 }
 
-std::string BigInteger::toString(void) const {
-  std::string str;
-
-  for (size_t j = 0; j < number_.size(); ++j) {
-    std::string tmp;
-    tmp.reserve(9);
-    uint32_t tmp_value = number_[j];
-
-    for (uint32_t i = 0; i < 9; ++i) {
-      tmp.push_back('0' + static_cast<char>(tmp_value % 10));
-      tmp_value /= 10;
-
-      if ((tmp_value == 0) && (j == number_.size() - 1)) {
-        break;
+// product holds 2 size_ + 1 limbs with a zero on top and is used as working space.
+template <typename Limbs>
+void BasicModContext<Limbs>::Reduce(Limb* product, Limb* out) const {
+  size_t k = size_;
+  const Limb* modulus = modulus_limbs_.data();
+  Limb* rest = nullptr;
+
+  if (montgomery_ && !inverse_limbs_.empty()) {
+    // product + ((product mod R) * inverse mod R) * modulus is divisible by R.
+    typename BigInt::Scratch& scratch = BigInt::ScratchSpace();
+    auto mark = scratch.Position();
+    Limb* factor = scratch.Take(2 * k);
+    Limb* multiple = scratch.Take(2 * k);
+    BigInt::MulLimbs(product, k, inverse_limbs_.data(), k, factor, BigInt::Algorithm::Auto);
+    BigInt::MulLimbs(factor, k, modulus, k, multiple, BigInt::Algorithm::Auto);
+    BigInt::AddLimbsInPlace(product, 2 * k + 1, multiple, 2 * k);
+    scratch.Release(mark);
+    rest = product + k;
+  } else if (montgomery_) {
+    // Adds u * modulus * kRang^i to clear limb i, then divides by R.
+    for (size_t i = 0; i < k; ++i) {
+      Limb u = static_cast<Limb>(static_cast<DoubleLimb>(product[i]) * inverse_ % kRang);
+      DoubleLimb old_tmp = 0;
+      for (size_t j = 0; j < k; ++j) {
+        DoubleLimb value = static_cast<DoubleLimb>(u) * modulus[j] + product[i + j] + old_tmp;
+        product[i + j] = static_cast<Limb>(value % kRang);
+        old_tmp = value / kRang;
+      }
+      for (size_t j = i + k; old_tmp != 0; ++j) {
+        DoubleLimb value = product[j] + old_tmp;
+        product[j] = static_cast<Limb>(value % kRang);
+        old_tmp = value / kRang;
       }
     }
-    std::reverse(tmp.begin(), tmp.end());
-    str = tmp + str;
+    rest = product + k;
+  } else {
+    // q = ((product / kRang^(k - 1)) * mu) / kRang^(k + 1) is at most three below the quotient.
+    typename BigInt::Scratch& scratch = BigInt::ScratchSpace();
+    auto mark = scratch.Position();
+    Limb* estimate = scratch.Take(2 * k + 2);
+    Limb* multiple = scratch.Take(2 * k + 1);
+    BigInt::MulLimbs(product + k - 1, k + 1, factor_.data(), k + 1, estimate, BigInt::Algorithm::Auto);
+    BigInt::MulLimbs(estimate + k + 1, k + 1, modulus, k, multiple, BigInt::Algorithm::Auto);
+    BigInt::SubLimbsInPlace(product, k + 1, multiple, k + 1);
+    scratch.Release(mark);
+    rest = product;
   }
 
-  if (sign_ == Negative) {
-    str = '-' + str;
+  while ((rest[k] != 0) || (BigInt::CompareLimbs(rest, k, modulus, k) >= 0)) {
+    BigInt::SubLimbsInPlace(rest, k + 1, modulus, k);
   }
+  std::copy(rest, rest + k, out);
+}
 
-  return str;
+// out = a * b / R (Montgomery) or a * b (Barrett) modulo the modulus; out may alias a or b.
+template <typename Limbs>
+void BasicModContext<Limbs>::Multiply(const Limb* a, const Limb* b, Limb* out) const {
+  typename BigInt::Scratch& scratch = BigInt::ScratchSpace();
+  auto mark = scratch.Position();
+  Limb* product = scratch.Take(2 * size_ + 1);
+  BigInt::MulLimbs(a, size_, b, size_, product, BigInt::Algorithm::Auto);
+  product[2 * size_] = 0;
+  Reduce(product, out);
+  scratch.Release(mark);
 }
 
-bool BigInteger::operator<(const BigInteger& big_int) const {
-  if (sign_ < big_int.sign_) {
-    return true;
+template <typename Limbs>
+std::vector<typename BasicModContext<Limbs>::Limb> BasicModContext<Limbs>::ToForm(const BigInt& big_int) const {
+  std::vector<Limb> value = Pad(reduce(big_int));
+  if (montgomery_) {
+    Multiply(value.data(), factor_.data(), value.data());
   }
+  return value;
+}
 
-  if (sign_ > big_int.sign_) {
-    return false;
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicModContext<Limbs>::FromForm(const std::vector<Limb>& value) const {
+  if (!montgomery_) {
+    return BigInt::FromLimbs(value.data(), size_);
   }
 
-  bool my_true = (sign_ == Positive);
-  bool my_false = !my_true;
+  std::vector<Limb> unit(size_, 0);
+  unit[0] = 1;
+  Multiply(value.data(), unit.data(), unit.data());
+  return BigInt::FromLimbs(unit.data(), size_);
+}
 
-  if (big_int.number_.size() > number_.size()) {
-    return my_true;
+// Left-to-right sliding window: squarings for every bit, one multiplication per window
+// of up to `width` bits ending in a one, taken from a table of odd powers.
+template <typename Limbs>
+std::vector<typename BasicModContext<Limbs>::Limb> BasicModContext<Limbs>::Pow(const std::vector<Limb>& base,
+                                                             const std::vector<uint64_t>& exponent) const {
+  size_t words = exponent.size();
+  while ((words > 0) && (exponent[words - 1] == 0)) {
+    --words;
   }
+  size_t bits = (words == 0 ? 0 : words * 64 - static_cast<size_t>(std::countl_zero(exponent[words - 1])));
+  auto bit = [&](size_t i) { return static_cast<size_t>((exponent[i / 64] >> (i % 64)) & 1); };
 
-  if (big_int.number_.size() < number_.size()) {
-    return my_false;
+  if (bits == 0) {
+    return one_;
   }
 
-  for (size_t i = number_.size(); i > 0; --i) {
-    if (big_int.number_[i - 1] > number_[i - 1]) {
-      return my_true;
-    }
-    if (big_int.number_[i - 1] < number_[i - 1]) {
-      return my_false;
+  size_t width = (bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : bits > 6 ? 2 : 1);
+  std::vector<Limb> table(size_ << (width - 1));
+  std::copy(base.begin(), base.end(), table.begin());
+  if (width > 1) {
+    std::vector<Limb> square(size_);
+    Multiply(base.data(), base.data(), square.data());
+    for (size_t i = 1; i < (size_t(1) << (width - 1)); ++i) {
+      Multiply(table.data() + (i - 1) * size_, square.data(), table.data() + i * size_);
     }
   }
 
-  return false;
-}
+  std::vector<Limb> result;
+  for (size_t i = bits; i > 0;) {
+    if (bit(i - 1) == 0) {
+      Multiply(result.data(), result.data(), result.data());
+      --i;
+      continue;
+    }
 
-bool BigInteger::operator==(const BigInteger& big_int) const {
-  if ((sign_ != big_int.sign_) || (number_.size() != big_int.number_.size())) {
-    return false;
-  }
+    size_t low = (i > width ? i - width : 0);
+    while (bit(low) == 0) {
+      ++low;
+    }
+    size_t window = 0;
+    for (size_t j = i; j > low; --j) {
+      window = window * 2 + bit(j - 1);
+    }
 
-  for (size_t j = 0; j < number_.size(); ++j) {
-    if (number_[j] != big_int.number_[j]) {
-      return false;
+    const Limb* power = table.data() + (window / 2) * size_;
+    if (result.empty()) {
+      result.assign(power, power + size_);
+    } else {
+      for (size_t j = low; j < i; ++j) {
+        Multiply(result.data(), result.data(), result.data());
+      }
+      Multiply(result.data(), power, result.data());
     }
+    i = low;
   }
 
-  return true;
+  return result;
 }
 
-BigInteger BigInteger::operator-() const {
-  BigInteger big_int = *this;
+// The modulus is odd and above every trial-division prime here; rounds beyond the
+// fixed prime bases use pseudo-random ones from a fixed seed, so answers are repeatable.
+template <typename Limbs>
+bool BasicModContext<Limbs>::MillerRabin(size_t rounds) const {
+  static constexpr uint32_t kBases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41};
 
-  if (big_int.sign_ == Positive) {
-    big_int.sign_ = Negative;
-  } else {
-    big_int.sign_ = Positive;
+  BigInt even = modulus_ - 1;
+  size_t shift = 0;
+  while (!even.test_bit(shift)) {
+    ++shift;
   }
-
-  return big_int;
-}
-
-BigInteger& BigInteger::operator+=(const BigInteger& big_int) {
-  if (sign_ == Positive) {
-    if (big_int.sign_ == Positive) {
-      *this = PositivePlusPositive(big_int);
-      return *this;
+  std::vector<uint64_t> exponent = BigInt::BinaryWords(even >> shift);
+
+  std::vector<Limb> minus_one = ToForm(modulus_ - 1);
+  BigInt range = modulus_ - 3;
+  std::mt19937_64 random(BigInt::ToWord(modulus_));
+  for (size_t round = 0; round < rounds; ++round) {
+    BigInt base;
+    if (round < std::size(kBases)) {
+      base = BigInt(static_cast<int>(kBases[round]));
+    } else {
+      std::vector<Limb> limbs(size_);
+      for (Limb& limb : limbs) {
+        limb = static_cast<Limb>(random() % kRang);
+      }
+      base = BigInt::FromLimbs(limbs.data(), size_) % range + 2;
     }
 
-    if (big_int.sign_ == Negative) {
-      *this = PositivePlusNegative(*this, big_int);
-      return *this;
+    std::vector<Limb> value = Pow(ToForm(base), exponent);
+    if ((value == one_) || (value == minus_one)) {
+      continue;
     }
 
-    return *this;
-  } else if (sign_ == Negative) {
-    if (big_int.sign_ == Positive) {
-      *this = PositivePlusNegative(big_int, *this);
-      return *this;
+    bool witness = true;
+    for (size_t i = 1; (i < shift) && witness; ++i) {
+      Multiply(value.data(), value.data(), value.data());
+      witness = (value != minus_one);
+      if (value == one_) {
+        return false;
+      }
     }
-    if (big_int.sign_ == Negative) {
-      *this = -PositivePlusPositive(big_int);
-      return *this;
+    if (witness) {
+      return false;
     }
-
-    return *this;
   }
 
-  *this = big_int;
-  return *this;
-}
-
-BigInteger BigInteger::operator+(const BigInteger& big_int) const {
-  BigInteger new_big_int = *this;
-  return std::move(new_big_int += big_int);
-}
-
-BigInteger operator+(int value, const BigInteger& big_int) {
-  return BigInteger(value) + big_int;
+  return true;
 }
 
-BigInteger& BigInteger::operator-=(const BigInteger& big_int) {
-  return *this += -big_int;
-}
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicModContext<Limbs>::reduce(const BigInt& big_int) const {
+  if ((big_int.sign_ == BigInt::Positive) && (BigInt::CompareAbs(big_int, modulus_) < 0)) {
+    return big_int;
+  }
 
-BigInteger BigInteger::operator-(const BigInteger& big_int) const {
-  BigInteger new_big_int = *this;
-  return std::move(new_big_int -= big_int);
+  BigInt result = big_int % modulus_;
+  if (result.sign_ == BigInt::Negative) {
+    result += modulus_;
+  }
+  return result;
 }
 
-BigInteger operator-(int value, const BigInteger& big_int) {
-  return BigInteger(value) - big_int;
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicModContext<Limbs>::multiply(const BigInt& big_int1, const BigInt& big_int2) const {
+  std::vector<Limb> value = Pad(reduce(big_int1));
+  std::vector<Limb> other = ToForm(big_int2);
+  Multiply(value.data(), other.data(), value.data());
+  return BigInt::FromLimbs(value.data(), size_);
 }
 
-BigInteger& BigInteger::operator*=(const BigInteger& big_int) {
-  if ((sign_ != Zero) && (big_int.sign_ != Zero)) {
-    Sign old_sign = sign_;
-
-    if (number_.size() <= big_int.number_.size()) {
-      *this = Multi(big_int, *this);
-    } else {
-      *this = Multi(*this, big_int);
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicModContext<Limbs>::pow(const BigInt& base, const BigInt& exponent) const {
+  if (exponent.sign_ == BigInt::Negative) {
+    BigInt inverted = inverse(base);
+    if (inverted.sign_ == BigInt::Zero) {
+      return inverted;
     }
-    if (old_sign == big_int.sign_) {
-      sign_ = Positive;
-    } else {
-      sign_ = Negative;
-    }
-
-    return *this;
+    return pow(inverted, -exponent);
   }
 
-  return (*this = std::move(BigInteger()));
+  return FromForm(Pow(ToForm(base), BigInt::BinaryWords(exponent)));
 }
 
-BigInteger BigInteger::operator*(const BigInteger& big_int) const {
-  BigInteger new_big_int = *this;
-  return std::move(new_big_int *= big_int);
-}
-
-BigInteger operator*(int value, const BigInteger& big_int) {
-  return BigInteger(value) * big_int;
-}
-
-BigInteger& BigInteger::operator/=(const BigInteger& big_int) {
-  if (Abs(*this) < Abs(big_int)) {
-    return *this = BigInteger();
-  }
-
-  if (big_int == 1) {
-    return *this;
+template <typename Limbs>
+BasicBigInteger<Limbs> BasicModContext<Limbs>::inverse(const BigInt& big_int) const {
+  auto [divisor, x, y] = xgcd(reduce(big_int), modulus_);
+  if (divisor != 1) {
+    return BigInt();
   }
+  return reduce(x);
+}
 
-  if (big_int == -1) {
-    return *this = -(*this);
-  }
+// base^exponent for a non-negative exponent.
+template <typename Limbs>
+BasicBigInteger<Limbs> pow(const BasicBigInteger<Limbs>& base, uint64_t exponent) {
+  BasicBigInteger<Limbs> result = 1;
+  BasicBigInteger<Limbs> power = base;
 
-  if (Abs(*this) == Abs(big_int)) {
-    if (sign_ != big_int.sign_) {
-      return *this = BigInteger(-1);
+  for (; exponent > 0; exponent >>= 1) {
+    if ((exponent & 1) != 0) {
+      mul(result, result, power);
     }
-    else {
-      return *this = BigInteger(1);
+    if (exponent > 1) {
+      mul(power, power, power);
     }
   }
 
-  Sign old_sign = sign_;
-  *this = Division(Abs(*this), Abs(big_int));
-  sign_ = (old_sign == big_int.sign_ ? Positive : Negative);
-
-  return *this;
-}
-
-BigInteger BigInteger::operator/(const BigInteger& big_int) const {
-  BigInteger new_big_int = *this;
-  return std::move(new_big_int /= big_int);
-}
-
-BigInteger operator/(int value, const BigInteger& big_int) {
-  return BigInteger(value) / big_int;
+  return result;
 }
 
-BigInteger& BigInteger::operator%=(const BigInteger &big_int) {
-  return *this = (*this - (*this / big_int) * big_int);
-}
-
-BigInteger BigInteger::operator%(const BigInteger &big_int) const {
-  BigInteger new_big_int = *this;
-  return new_big_int %= big_int;
-}
-
-BigInteger operator%(int value, const BigInteger& big_int) {
-  return BigInteger(value) % big_int;
+template <typename Limbs>
+void BasicModContext<Limbs>::multiply_batch(std::span<const BigInt> big_ints1, std::span<const BigInt> big_ints2,
+                                            std::span<BigInt> result) const {
+  size_t count = std::min({big_ints1.size(), big_ints2.size(), result.size()});
+  std::vector<BigInt> products(count);
+  for (size_t i = 0; i < count; ++i) {
+    products[i] = reduce(big_ints1[i]);
+    result[i] = reduce(big_ints2[i]);
+  }
+  BigInt::multiply_batch(products, std::span<const BigInt>(result.data(), count), products);
+
+  // Reduce gives a * b in Barrett form; in Montgomery form a * b / R, which one more
+  // product with R^2 puts right.
+  BigInt::ForEachRange(count, count * size_, [&](size_t begin, size_t end) {
+    typename BigInt::Scratch& scratch = BigInt::ScratchSpace();
+    for (size_t i = begin; i < end; ++i) {
+      auto mark = scratch.Position();
+      Limb* product = scratch.Take(2 * size_ + 1);
+      Limb* out = scratch.Take(size_);
+      std::fill(product, product + 2 * size_ + 1, Limb(0));
+      std::copy(products[i].number_.begin(), products[i].number_.end(), product);
+
+      Reduce(product, out);
+      if (montgomery_) {
+        Multiply(out, factor_.data(), out);
+      }
+      result[i] = BigInt::FromLimbs(out, size_);
+      scratch.Release(mark);
+    }
+  });
 }
 
-BigInteger& BigInteger::operator++() {
-  return *this += 1;
-}
+template <typename Limbs>
+void BasicModContext<Limbs>::pow_batch(std::span<const BigInt> bases, std::span<const BigInt> exponents,
+                                       std::span<BigInt> result) const {
+  size_t count = std::min({bases.size(), exponents.size(), result.size()});
+  // Every exponent bit costs a product of size_ limbs.
+  size_t work = 0;
+  for (size_t i = 0; i < count; ++i) {
+    work += static_cast<size_t>(exponents[i].bit_length()) * size_;
+  }
 
-BigInteger& BigInteger::operator--() {
-  return *this -= 1;
+  BigInt::ForEachRange(count, work, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      result[i] = pow(bases[i], exponents[i]);
+    }
+  });
 }
 
-BigInteger BigInteger::operator++(int) {
-  BigInteger big_int = *this;
-  ++*this;
-  return big_int;
+// base^exponent mod modulus in [0, modulus) for a positive modulus; a one-off BasicModContext.
+template <typename Limbs>
+BasicBigInteger<Limbs> powmod(const BasicBigInteger<Limbs>& base, const BasicBigInteger<Limbs>& exponent,
+                              const BasicBigInteger<Limbs>& modulus) {
+  return BasicModContext<Limbs>(modulus).pow(base, exponent);
 }
 
-BigInteger BigInteger::operator--(int) {
-  BigInteger big_int = *this;
-  --*this;
-  return big_int;
+// x in [0, modulus) with big_int * x = 1 mod modulus; zero when there is none.
+template <typename Limbs>
+BasicBigInteger<Limbs> modinv(const BasicBigInteger<Limbs>& big_int, const BasicBigInteger<Limbs>& modulus) {
+  return BasicModContext<Limbs>(modulus).inverse(big_int);
 }
 
-BigInteger operator""_bi(const char* str) {
-  BigInteger big_int(str);
-  return big_int;
-}
+// Trial division by the primes below 100, then Miller-Rabin with `rounds` bases.
+// A false answer is always right; a composite passes with probability below 4^-rounds.
+template <typename Limbs>
+bool is_probable_prime(const BasicBigInteger<Limbs>& big_int, size_t rounds) {
+  static constexpr int kSmallPrimes[] = {2,  3,  5,  7,  11, 13, 17, 19, 23, 29, 31, 37, 41,
+                                         43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97};
 
-std::ostream& operator<<(std::ostream& out, const BigInteger& big_int) {
-  out << big_int.toString();
-  return out;
-}
+  if (big_int < 2) {
+    return false;
+  }
+  for (int prime : kSmallPrimes) {
+    if (big_int % prime == 0) {
+      return big_int == prime;
+    }
+  }
+  if (big_int < 100 * 100) {
+    return true;
+  }
 
-std::istream& operator>>(std::istream& in, BigInteger& big_int) {
-  std::string str;
-  in >> str;
-  big_int = str;
-  return in;
+  return BasicModContext<Limbs>(big_int).MillerRabin(rounds);
 }
 
+// Kept in lowest terms with a positive denominator, so equal values have equal members.
 class Rational {
 private:
   BigInteger numerator_;
   BigInteger denominator_;
 
-  BigInteger Evklid(BigInteger big_int1, BigInteger big_int2) const;
-  Rational Opposite(const Rational& rat) const;
+  void AddSigned(const Rational& rat, bool subtract);
+  void MultiplyBy(const BigInteger& numerator, const BigInteger& denominator);
 
 public:
   Rational() : numerator_(0), denominator_(1) {}
@@ -690,35 +3907,13 @@ public:
   bool operator==(const Rational& rat) const;
   bool operator!=(const Rational& rat) const { return !(*this == rat); }
 
+  // Truncated towards zero after precesion digits.
   std::string asDecimal(size_t precesion) const;
+  // Correctly rounded (to nearest, ties to even), including subnormals and overflow to infinity.
+  double to_double() const;
   explicit operator double() const;
 };
 
-BigInteger Rational::Evklid(BigInteger big_int1, BigInteger big_int2) const {
-  while ((big_int1 > 0) && (big_int2 > 0)) {
-    if (big_int1 < big_int2) {
-      big_int2 %= big_int1;
-    } else if (big_int2 < big_int1) {
-      big_int1 %= big_int2;
-    } else {
-      return std::move(big_int1);
-    }
-  }
-
-  if (big_int1 > big_int2) {
-    return std::move(big_int1);
-  }
-
-  return std::move(big_int2);
-}
-
-Rational Rational::Opposite(const Rational &rat) const {
-  Rational new_rat;
-  new_rat.numerator_ = (rat.numerator_.sign_ == BigInteger::Negative ? -rat.denominator_ : rat.denominator_);
-  new_rat.denominator_ = (rat.numerator_.sign_ == BigInteger::Negative ? -rat.numerator_ : rat.numerator_);
-  return std::move(new_rat);
-}
-
 Rational Rational::operator-() const {
   Rational rat = *this;
 
@@ -734,10 +3929,80 @@ Rational Rational::operator-() const {
   return std::move(rat);
 }
 
+// Henrici: with g = gcd(d1, d2) the result's common factor can only divide g.
+void Rational::AddSigned(const Rational& rat, bool subtract) {
+  if (&rat == this) {
+    Rational copy = rat;
+    AddSigned(copy, subtract);
+    return;
+  }
+
+  auto fused = [subtract](BigInteger& acc, const BigInteger& big_int1, const BigInteger& big_int2) {
+    if (subtract) {
+      submul(acc, big_int1, big_int2);
+    } else {
+      addmul(acc, big_int1, big_int2);
+    }
+  };
+
+  BigInteger common = gcd(denominator_, rat.denominator_);
+  if (common == 1) {
+    numerator_ *= rat.denominator_;
+    fused(numerator_, rat.numerator_, denominator_);
+    denominator_ *= rat.denominator_;
+    return;
+  }
+
+  BigInteger other_part = rat.denominator_ / common;
+  numerator_ *= other_part;
+  fused(numerator_, rat.numerator_, denominator_ / common);
+
+  if (numerator_.sign_ == BigInteger::Zero) {
+    denominator_ = 1;
+    return;
+  }
+
+  BigInteger factor = gcd(numerator_, common);
+  if (factor != 1) {
+    numerator_ /= factor;
+    denominator_ /= factor;
+  }
+  denominator_ *= other_part;
+}
+
+// Cross-cancellation keeps the products in lowest terms without a gcd of the full products.
+void Rational::MultiplyBy(const BigInteger& numerator, const BigInteger& denominator) {
+  if ((numerator_.sign_ == BigInteger::Zero) || (numerator.sign_ == BigInteger::Zero)) {
+    numerator_ = 0;
+    denominator_ = 1;
+    return;
+  }
+
+  BigInteger factor1 = gcd(numerator_, denominator);
+  BigInteger factor2 = gcd(numerator, denominator_);
+  numerator_ /= factor1;
+  denominator_ /= factor2;
+
+  if (factor2 == 1) {
+    numerator_ *= numerator;
+  } else {
+    numerator_ *= numerator / factor2;
+  }
+  if (factor1 == 1) {
+    denominator_ *= denominator;
+  } else {
+    denominator_ *= denominator / factor1;
+  }
+
+  if (denominator_.sign_ == BigInteger::Negative) {
+    numerator_.sign_ = static_cast<BigInteger::Sign>(-numerator_.sign_);
+    denominator_.sign_ = BigInteger::Positive;
+  }
+}
+
 Rational& Rational::operator+=(const Rational &rat) {
   //std::cerr << "+= " << toString() << " " << rat.toString() << "\n";
-  numerator_ = numerator_ * rat.denominator_ + rat.numerator_ * denominator_;
-  denominator_ *= rat.denominator_;
+  AddSigned(rat, false);
   return *this;
 }
 
@@ -752,7 +4017,8 @@ Rational operator+(int value, const Rational &rat) {
 
 Rational& Rational::operator-=(const Rational &rat) {
   //std::cerr << "-= " << toString() << " " << rat.toString() << "\n";
-  return *this += -rat;
+  AddSigned(rat, true);
+  return *this;
 }
 
 Rational Rational::operator-(const Rational &rat) const {
@@ -766,8 +4032,13 @@ Rational operator-(int value, const Rational &rat) {
 
 Rational& Rational::operator*=(const Rational &rat) {
   //std::cerr << "*= " << toString() << " " << rat.toString() << "\n";
-  numerator_ *= rat.numerator_;
-  denominator_ *= rat.denominator_;
+  if (&rat == this) {
+    numerator_ *= numerator_;
+    denominator_ *= denominator_;
+    return *this;
+  }
+
+  MultiplyBy(rat.numerator_, rat.denominator_);
   return *this;
 }
 
@@ -782,7 +4053,14 @@ Rational operator*(int value, const Rational &rat) {
 
 Rational& Rational::operator/=(const Rational &rat) {
   //std::cerr << "/= " << toString() << " " << rat.toString() << "\n";
-  return *this *= Opposite(rat);
+  if (&rat == this) {
+    numerator_ = 1;
+    denominator_ = 1;
+    return *this;
+  }
+
+  MultiplyBy(rat.denominator_, rat.numerator_);
+  return *this;
 }
 
 Rational Rational::operator/(const Rational &rat) const {
@@ -801,15 +4079,7 @@ std::string Rational::toString() const {
     return numerator_.toString();
   }
 
-  BigInteger gcd = std::move(Evklid(numerator_.Abs(numerator_), denominator_.Abs(denominator_)));
-  BigInteger new_num = numerator_ / gcd;
-  BigInteger new_den = denominator_ / gcd;
-
-  if ((new_den == 1) || (new_num == 0)) {
-    return new_num.toString();
-  }
-
-  return std::move(new_num.toString() + "/" + new_den.toString());
+  return numerator_.toString() + "/" + denominator_.toString();
 }
 
 bool Rational::operator<(const Rational &rat) const {
@@ -821,71 +4091,103 @@ bool Rational::operator<(const Rational &rat) const {
     return false;
   }
 
-  return numerator_ * rat.denominator_ < rat.numerator_ * denominator_;
+  BigInteger difference = numerator_ * rat.denominator_;
+  submul(difference, rat.numerator_, denominator_);
+  return difference.sign_ == BigInteger::Negative;
 }
 
 bool Rational::operator==(const Rational &rat) const {
   //std::cerr << "==\n";
-  if (numerator_.sign_ != rat.numerator_.sign_) {
-    return false;
-  }
-
-  return numerator_ * rat.denominator_ == rat.numerator_ * denominator_;
+  return (numerator_ == rat.numerator_) && (denominator_ == rat.denominator_);
 }
 
 std::string Rational::asDecimal(size_t precision) const {
   //std::cerr << "asD\n";
   std::string str;
-  Rational rat = *this;
-
-  if (rat.numerator_.sign_ == BigInteger::Zero) {
-    if (precision == 0) {
-      return "0";
-    } else {
-      return "0." + std::string(precision, '0');
-    }
-  } else if (rat.numerator_.sign_ == BigInteger::Negative) {
+  if (numerator_.sign_ == BigInteger::Negative) {
     str.push_back('-');
   }
 
-  BigInteger integer = std::move(rat.numerator_ / rat.denominator_);
-  str += integer.Abs(integer).toString();
+  // |numerator| * 10^precision / denominator holds every digit that is printed.
+  BigInteger scaled = BigInteger("1" + std::string(precision, '0'));
+  scaled *= numerator_;
+  scaled.sign_ = (scaled.sign_ == BigInteger::Zero ? BigInteger::Zero : BigInteger::Positive);
+  std::string digits = (scaled / denominator_).toString();
+
+  if (digits.size() <= precision) {
+    digits.insert(0, precision + 1 - digits.size(), '0');
+  }
+
+  str.append(digits, 0, digits.size() - precision);
+  if (precision != 0) {
+    str.push_back('.');
+    str.append(digits, digits.size() - precision, precision);
+  }
+
+  return str;
+}
 
-  if (precision == 0) {
-    return str;
+double Rational::to_double() const {
+  if (numerator_.sign_ == BigInteger::Zero) {
+    return 0.0;
   }
-  str.push_back('.');
 
-  size_t ind = 0;
-  BigInteger step = 10;
-  std::string floating;
-  rat -= integer;
+  constexpr int kMantissaBits = 53;
+  constexpr int kMinExponent = -1074;
+
+  BigInteger numerator = numerator_;
+  numerator.sign_ = BigInteger::Positive;
 
-  while (ind < precision) {
-    BigInteger value;
-    while (((value = (rat.numerator_ * step) / rat.denominator_) == 0) && (ind < precision)) {
-      floating += "0";
-      ind += 1;
-      step *= 10;
+  // Scale so that numerator * 2^shift / denominator lands in [2^54, 2^58): 53 bits, a rounding bit and more.
+  int64_t shift = 56 - static_cast<int64_t>(std::floor(BigInteger::ApproxBitLength(numerator) -
+                                                         BigInteger::ApproxBitLength(denominator_)));
+  uint64_t quotient = 0;
+  bool sticky = false;
+
+  while (true) {
+    std::pair<BigInteger, BigInteger> result;
+    if (shift >= 0) {
+      result = BigInteger::divmod(numerator << static_cast<size_t>(shift), denominator_);
+    } else {
+      result = BigInteger::divmod(numerator, denominator_ << static_cast<size_t>(-shift));
     }
 
-    if (ind != precision) {
-      floating += value.Abs(value).toString();
-      (rat.numerator_ *= step) -= value * rat.denominator_;
-      step = 10;
+    if (result.first >= BigInteger::FromWord(uint64_t(1) << 58)) {
+      shift -= 2;
+      continue;
     }
+    quotient = BigInteger::ToWord(result.first);
+    if (quotient < (uint64_t(1) << 54)) {
+      shift += 2;
+      continue;
+    }
+    sticky = (result.second.sign_ != BigInteger::Zero);
+    break;
+  }
+
+  // value = (quotient + fraction) * 2^-shift with fraction != 0 exactly when sticky.
+  int bits = std::bit_width(quotient);
+  int64_t exponent = bits - 1 - shift;
+  int64_t precision = std::min<int64_t>(kMantissaBits, exponent - kMinExponent + 1);
+  if (precision < 0) {
+    return (numerator_.sign_ == BigInteger::Negative ? -0.0 : 0.0);
   }
 
-  while (floating.size() > precision) {
-    floating.pop_back();
+  int drop = bits - static_cast<int>(precision);
+  uint64_t mantissa = quotient >> drop;
+  uint64_t rest = quotient & ((uint64_t(1) << drop) - 1);
+  uint64_t half = uint64_t(1) << (drop - 1);
+  if ((rest > half) || ((rest == half) && (sticky || ((mantissa & 1) != 0)))) {
+    ++mantissa;
   }
 
-  return std::move(str + floating);
+  int64_t scale = std::clamp<int64_t>(drop - shift, -2000, 2000);
+  double value = std::ldexp(static_cast<double>(mantissa), static_cast<int>(scale));
+  return (numerator_.sign_ == BigInteger::Negative ? -value : value);
 }
 
 Rational::operator double() const {
-  double value = std::stod(asDecimal(10));
-  return value;
+  return to_double();
 }
 
 std::ostream& operator<<(std::ostream& out, const Rational& rat) {
@@ -1,5 +1,43 @@
 #include "biginteger.h"
 
+#include <cstdlib>
+#include <new>
+
+size_t allocations = 0;
+
+// Every allocating and deallocating form is replaced, so that each delete matches its new.
+void* CountedAllocate(size_t size) {
+  ++allocations;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new(size_t size) {
+  return CountedAllocate(size);
+}
+
+void* operator new[](size_t size) {
+  return CountedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
 void ComarisonCheck(void) {
   std::cout << "Comparison:\n";
 
@@ -22,6 +60,596 @@ void ComarisonCheck(void) {
   std::cout << (BigInteger(1) != BigInteger(0)) << "\n\n";
 }
 
+void MultiplyCheck(void) {
+  std::cout << "Multiplication algorithms:\n";
+
+  std::string str1;
+  std::string str2 = "-";
+  for (int i = 0; i < 30000; ++i) {
+    str1 += std::to_string(rand() % 9 + 1);
+    str2 += std::to_string(rand() % 9 + 1);
+  }
+
+  BigInteger a(str1);
+  BigInteger b(str2);
+  BigInteger result = BigInteger::multiply(a, b, BigInteger::Algorithm::Schoolbook);
+
+  std::cout << "Karatsuba == Schoolbook\n";
+  std::cout << (BigInteger::multiply(a, b, BigInteger::Algorithm::Karatsuba) == result) << "\n";
+
+  std::cout << "ToomCook3 == Schoolbook\n";
+  std::cout << (BigInteger::multiply(a, b, BigInteger::Algorithm::ToomCook3) == result) << "\n";
+
+  std::cout << "Ntt == Schoolbook\n";
+  std::cout << (BigInteger::multiply(a, b, BigInteger::Algorithm::Ntt) == result) << "\n";
+
+  std::cout << "a * b == Schoolbook\n";
+  std::cout << (a * b == result) << "\n\n";
+}
+
+void DivisionCheck(void) {
+  std::cout << "Division:\n";
+
+  std::string str1 = "-";
+  std::string str2;
+  for (int i = 0; i < 20000; ++i) {
+    str1 += std::to_string(rand() % 9 + 1);
+  }
+  for (int i = 0; i < 7000; ++i) {
+    str2 += std::to_string(rand() % 9 + 1);
+  }
+
+  BigInteger a(str1);
+  BigInteger b(str2);
+  auto [quotient, remainder] = BigInteger::divmod(a, b);
+
+  std::cout << "q * b + r == a\n";
+  std::cout << (quotient * b + remainder == a) << "\n";
+
+  std::cout << "-b < r <= 0\n";
+  std::cout << ((-b < remainder) && (remainder <= 0)) << "\n";
+
+  std::cout << "a / b == q, a % b == r\n";
+  std::cout << ((a / b == quotient) && (a % b == remainder)) << "\n\n";
+}
+
+void LimbsCheck() {
+  std::cout << "Limb backends:\n";
+  std::string str1 = "-";
+  std::string str2;
+  for (int i = 0; i < 12000; ++i) {
+    str1 += std::to_string(rand() % 9 + 1);
+  }
+  for (int i = 0; i < 5000; ++i) {
+    str2 += std::to_string(rand() % 9 + 1);
+  }
+
+  BasicBigInteger<DecimalLimbs> decimal1(str1);
+  BasicBigInteger<DecimalLimbs> decimal2(str2);
+  BasicBigInteger<BinaryLimbs> binary1(str1);
+  BasicBigInteger<BinaryLimbs> binary2(str2);
+
+  std::cout << "toString(BinaryLimbs(str)) == str\n";
+  std::cout << (binary1.toString() == str1) << "\n";
+
+  std::cout << "BinaryLimbs == DecimalLimbs for +, *, /, %\n";
+  std::cout << (((binary1 + binary2).toString() == (decimal1 + decimal2).toString()) &&
+                ((binary1 * binary2).toString() == (decimal1 * decimal2).toString()) &&
+                ((binary1 / binary2).toString() == (decimal1 / decimal2).toString()) &&
+                ((binary1 % binary2).toString() == (decimal1 % decimal2).toString())) << "\n\n";
+}
+
+void StorageCheck() {
+  std::cout << "inline and spilled limbs:\n";
+  // 60 digits take past the inline limbs of either backend: 4 decimal ones hold 36 digits, 2 binary ones 38.
+  std::vector<std::string> texts;
+  std::string text;
+  BigInteger value;
+  bool grown = true;
+  for (int i = 1; i <= 60; ++i) {
+    int digit = i % 9 + 1;
+    value = value * 10 + digit;
+    text += static_cast<char>('0' + digit);
+    texts.push_back(text);
+
+    BigInteger copy = value;
+    BigInteger moved = std::move(copy);
+    BigInteger inline_target = 5;
+    inline_target = moved;
+    BigInteger spilled_target("123456789012345678901234567890123456789012345678901234567890");
+    spilled_target = std::move(moved);
+    grown = grown && (inline_target.toString() == text) && (spilled_target.toString() == text);
+  }
+
+  bool shrunk = true;
+  for (size_t i = texts.size(); i > 0; --i) {
+    BigInteger copy;
+    copy = value;
+    shrunk = shrunk && (value.toString() == texts[i - 1]) && (copy.toString() == texts[i - 1]);
+    value /= 10;
+  }
+  shrunk = shrunk && (value == 0);
+
+  // Numbers made on the default resource take values made on an arena and keep them once it is gone.
+  std::vector<BigInteger> outside(texts.size(), BigInteger(7));
+  std::vector<char> buffer(size_t(1) << 20);
+  {
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    std::pmr::memory_resource* previous = BigInteger::set_memory_resource(&arena);
+    for (size_t i = 0; i < texts.size(); ++i) {
+      BigInteger inside(texts[i]);
+      BigInteger spare = inside;
+      outside[i] = std::move(inside);
+      if (i % 2 == 0) {
+        outside[i] = spare;
+      }
+    }
+    BigInteger::set_memory_resource(previous);
+  }
+  std::fill(buffer.begin(), buffer.end(), char(-1));
+
+  bool across = true;
+  for (size_t i = 0; i < texts.size(); ++i) {
+    across = across && (outside[i].toString() == texts[i]);
+  }
+
+  std::cout << "grow past the inline limbs and back, copy and move at each size\n";
+  std::cout << (grown && shrunk) << "\n";
+  std::cout << "copy and move from an arena into the default resource\n";
+  std::cout << across << "\n\n";
+}
+
+// Schoolbook sums of digit strings, to check the limb kernels against.
+std::string AddDigits(const std::string& str1, const std::string& str2) {
+  std::string result;
+  int carry = 0;
+  for (size_t i = 0; (i < str1.size()) || (i < str2.size()) || (carry != 0); ++i) {
+    int digit = carry;
+    digit += (i < str1.size() ? str1[str1.size() - 1 - i] - '0' : 0);
+    digit += (i < str2.size() ? str2[str2.size() - 1 - i] - '0' : 0);
+    result += static_cast<char>('0' + digit % 10);
+    carry = digit / 10;
+  }
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+// str1 - str2 for str1 >= str2.
+std::string SubDigits(const std::string& str1, const std::string& str2) {
+  std::string result;
+  int borrow = 0;
+  for (size_t i = 0; i < str1.size(); ++i) {
+    int digit = str1[str1.size() - 1 - i] - '0' - borrow;
+    digit -= (i < str2.size() ? str2[str2.size() - 1 - i] - '0' : 0);
+    borrow = (digit < 0 ? 1 : 0);
+    result += static_cast<char>('0' + digit + 10 * borrow);
+  }
+  while ((result.size() > 1) && (result.back() == '0')) {
+    result.pop_back();
+  }
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+std::string NegateDigits(const std::string& str) {
+  if (str == "0") {
+    return str;
+  }
+  return (str[0] == '-' ? str.substr(1) : "-" + str);
+}
+
+void AddSubCheck() {
+  std::cout << "Add and sub kernels:\n";
+  // Lengths around whole limbs of either backend, from none up to nine of them.
+  std::vector<size_t> lengths = {0,  1,  8,  9,  10, 18, 19, 20,  27,  36,  38, 39,
+                                 45, 54, 57, 63, 72, 76, 81, 95, 114, 133, 152, 171};
+  bool random = true;
+  for (size_t length1 : lengths) {
+    for (size_t length2 : lengths) {
+      std::string str1 = std::to_string(length1 == 0 ? 0 : rand() % 9 + 1);
+      std::string str2 = std::to_string(length2 == 0 ? 0 : rand() % 9 + 1);
+      while (str1.size() < length1) {
+        str1 += std::to_string(rand() % 10);
+      }
+      while (str2.size() < length2) {
+        str2 += std::to_string(rand() % 10);
+      }
+      bool less = (str1.size() != str2.size() ? str1.size() < str2.size() : str1 < str2);
+      std::string sum = AddDigits(str1, str2);
+      std::string difference = (less ? NegateDigits(SubDigits(str2, str1)) : SubDigits(str1, str2));
+      std::string negated = NegateDigits(difference);
+
+      BigInteger big_int1(str1);
+      BigInteger big_int2(str2);
+      BigInteger in_place = big_int1;
+      in_place += big_int2;
+      in_place -= big_int2;
+      random = random && ((big_int1 + big_int2).toString() == sum) &&
+               ((big_int1 - big_int2).toString() == difference) && ((-big_int1 - -big_int2).toString() == negated) &&
+               ((big_int1 + -big_int2).toString() == difference) && ((-big_int1 + big_int2).toString() == negated) &&
+               ((-big_int1 - big_int2).toString() == NegateDigits(sum)) && (in_place.toString() == str1);
+    }
+  }
+
+  // 10^k - 1 + 1 carries through every limb, and 2^(64k) - 1 through every binary one.
+  bool chains = true;
+  std::string nines;
+  for (size_t k = 1; k <= 171; ++k) {
+    nines += '9';
+    std::string power = "1" + std::string(k, '0');
+    BigInteger all_nines(nines);
+    chains = chains && ((all_nines + 1).toString() == power) && ((BigInteger(power) - all_nines) == 1) &&
+             ((BigInteger(power) - 1).toString() == nines) && ((-all_nines - 1).toString() == "-" + power);
+  }
+  for (size_t k = 0; k <= 9; ++k) {
+    BigInteger power = BigInteger(1) << (64 * k);
+    BigInteger ones = power - 1;
+    chains = chains && ((ones + 1) == power) && ((power - ones) == 1) && ((ones - power) == -1) &&
+             ((-ones - 1) == -power) && (((ones + ones) + 2) == (power << 1));
+  }
+
+  std::cout << "a + b, a - b with signs mixed against digit strings, 0 to 9 limbs\n";
+  std::cout << random << "\n";
+  std::cout << "carry chains: 10^k - 1 + 1, 2^(64k) - 1 + 1\n";
+  std::cout << chains << "\n\n";
+}
+
+void CharsCheck() {
+  std::cout << "from_chars / to_chars:\n";
+  std::string_view text = "-000123456789012345678901234567890x";
+  BigInteger big_int;
+  auto parsed = BigInteger::from_chars(text.data(), text.data() + text.size(), big_int);
+
+  std::cout << "\"-000123456789012345678901234567890x\" stops at 'x'\n";
+  std::cout << ((parsed.ec == std::errc()) && (*parsed.ptr == 'x') &&
+                (big_int == BigInteger("-123456789012345678901234567890"))) << "\n";
+
+  std::string_view bad = "-x";
+  auto failed = BigInteger::from_chars(bad.data(), bad.data() + bad.size(), big_int);
+  std::cout << "\"-x\" is invalid_argument\n";
+  std::cout << ((failed.ec == std::errc::invalid_argument) && (failed.ptr == bad.data())) << "\n";
+
+  char buffer[40];
+  auto written = BigInteger::to_chars(buffer, buffer + sizeof(buffer), big_int);
+  auto too_small = BigInteger::to_chars(buffer, buffer + 10, big_int);
+  std::cout << "to_chars round trip, value_too_large on a short buffer\n";
+  std::cout << ((std::string_view(buffer, written.ptr - buffer) == "-123456789012345678901234567890") &&
+                (too_small.ec == std::errc::value_too_large)) << "\n\n";
+}
+
+void AllocationCheck() {
+  std::cout << "Allocations:\n";
+  std::string str1;
+  std::string str2 = "-";
+  for (int i = 0; i < 2000; ++i) {
+    str1 += std::to_string(rand() % 9 + 1);
+  }
+  for (int i = 0; i < 1500; ++i) {
+    str2 += std::to_string(rand() % 9 + 1);
+  }
+
+  BigInteger x(str1);
+  BigInteger y(str2);
+  BigInteger acc(1);
+  BigInteger product;
+
+  auto step = [&]() {
+    acc += x * y;
+    acc -= y * x;
+    product += x;
+    product *= y;
+    product -= product;
+  };
+
+  for (int i = 0; i < 10; ++i) {
+    step();
+  }
+  size_t before = allocations;
+  for (int i = 0; i < 1000; ++i) {
+    step();
+  }
+
+  std::cout << "acc += x * y, acc -= y * x, product *= y allocate nothing after warm-up\n";
+  std::cout << ((allocations == before) && (acc == 1)) << "\n\n";
+}
+
+void GcdCheck() {
+  std::cout << "gcd / lcm / xgcd:\n";
+  std::string str1;
+  std::string str2 = "-";
+  std::string str3;
+  for (int i = 0; i < 3000; ++i) {
+    str1 += std::to_string(rand() % 9 + 1);
+  }
+  for (int i = 0; i < 2500; ++i) {
+    str2 += std::to_string(rand() % 9 + 1);
+  }
+  for (int i = 0; i < 500; ++i) {
+    str3 += std::to_string(rand() % 9 + 1);
+  }
+
+  BigInteger common(str3);
+  BigInteger a = BigInteger(str1) * common;
+  BigInteger b = BigInteger(str2) * common;
+  BigInteger g = gcd(a, b);
+  auto [g2, x, y] = xgcd(a, b);
+
+  std::cout << "gcd(a * c, b * c) is a multiple of c dividing both\n";
+  std::cout << ((g % common == 0) && (a % g == 0) && (b % g == 0) && (gcd(a / g, b / g) == 1)) << "\n";
+
+  std::cout << "a * x + b * y == gcd, lcm * gcd == |a * b|\n";
+  std::cout << ((g2 == g) && (a * x + b * y == g) && (lcm(a, b) * g == -(a * b))) << "\n";
+
+  BigInteger multiple("-100000000000000000000000000000000000000000000000000");
+  BigInteger divisor("10000000000");
+  auto [g3, x3, y3] = xgcd(multiple, divisor);
+  std::cout << "xgcd of a negative multiple and its divisor\n";
+  std::cout << ((g3 == divisor) && (x3 == 0) && (multiple * x3 + divisor * y3 == g3)) << "\n";
+
+  BigInteger negated_zero = -BigInteger(0);
+  std::cout << "-0 is zero: gcd(5, -0), gcd(-0, 5), lcm(-0, 5), -0 % 7, -0 << 5\n";
+  std::cout << ((negated_zero == BigInteger(0)) && (gcd(BigInteger(5), negated_zero) == 5) &&
+                (gcd(negated_zero, BigInteger(5)) == 5) && (lcm(negated_zero, BigInteger(5)) == 0) &&
+                (negated_zero % 7 == BigInteger(0)) && ((negated_zero << 5) == BigInteger(0)) &&
+                (BigInteger(-14) % 7 == BigInteger(0))) << "\n";
+
+  Rational harmonic;
+  for (int k = 1; k <= 30; ++k) {
+    harmonic += Rational(1) / Rational(k);
+  }
+  std::cout << "Rational stays in lowest terms: H_30, -6/4 * 10/-9, 1/3 - 1/3\n";
+  std::cout << ((harmonic.toString() == "9304682830147/2329089562800") &&
+                ((Rational(-6) / Rational(4) * (Rational(10) / Rational(-9))).toString() == "5/3") &&
+                ((Rational(1) / Rational(3) - Rational(1) / Rational(3)).toString() == "0")) << "\n\n";
+}
+
+void DecimalCheck() {
+  std::cout << "asDecimal / to_double:\n";
+  Rational third = Rational(-1) / Rational(3);
+  Rational big = Rational(BigInteger("1" + std::string(400, '0')));
+
+  std::cout << "-1/3 to 5 digits, 22/7 to 0 digits, 1/8 to 4 digits\n";
+  std::cout << ((third.asDecimal(5) == "-0.33333") && ((Rational(22) / Rational(7)).asDecimal(0) == "3") &&
+                ((Rational(1) / Rational(8)).asDecimal(4) == "0.1250")) << "\n";
+
+  std::cout << "-1/3, 2^53 + 1 (tie to even), 10^400 and 10^-400 as double\n";
+  std::cout << ((third.to_double() == -1.0 / 3) &&
+                (Rational(BigInteger("9007199254740993")).to_double() == 9007199254740992.0) &&
+                (big.to_double() == HUGE_VAL) && ((Rational(1) / big).to_double() == 0.0)) << "\n\n";
+}
+
+void FusedCheck() {
+  std::cout << "mul / addmul / submul:\n";
+  std::string str1;
+  std::string str2 = "-";
+  for (int i = 0; i < 1500; ++i) {
+    str1 += std::to_string(rand() % 9 + 1);
+  }
+  for (int i = 0; i < 1200; ++i) {
+    str2 += std::to_string(rand() % 9 + 1);
+  }
+
+  BigInteger a(str1);
+  BigInteger b(str2);
+  BigInteger c = a + 12345;
+  BigInteger d = b - 678;
+  BigInteger result;
+
+  mul(result, a, b);
+  addmul(result, c, d);
+  std::cout << "mul(r, a, b); addmul(r, c, d) == a * b + c * d\n";
+  std::cout << (result == a * b + c * d) << "\n";
+
+  submul(result, result, BigInteger(1));
+  addmul(a, a, b);
+  std::cout << "submul(r, r, 1) == 0, addmul(a, a, b) == a * (1 + b)\n";
+  std::cout << ((result == 0) && (a == c * (b + 1) - 12345 * (b + 1))) << "\n";
+
+  for (int i = 0; i < 10; ++i) {
+    addmul(result, c, d);
+    submul(result, d, c);
+  }
+  size_t before = allocations;
+  for (int i = 0; i < 1000; ++i) {
+    addmul(result, c, d);
+    submul(result, d, c);
+  }
+  std::cout << "addmul / submul allocate nothing after warm-up\n";
+  std::cout << ((allocations == before) && (result == 0)) << "\n\n";
+}
+
+void ParallelCheck() {
+  std::cout << "parallel multiply:\n";
+  std::string str1;
+  std::string str2;
+  for (int i = 0; i < 60000; ++i) {
+    str1 += std::to_string(rand() % 10);
+  }
+  for (int i = 0; i < 45000; ++i) {
+    str2 += std::to_string(rand() % 9 + 1);
+  }
+
+  BigInteger a(str1);
+  BigInteger b("-" + str2);
+  BigInteger::Algorithm algorithms[] = {BigInteger::Algorithm::Karatsuba, BigInteger::Algorithm::ToomCook3,
+                                        BigInteger::Algorithm::Ntt};
+  BigInteger serial[3];
+  for (int i = 0; i < 3; ++i) {
+    serial[i] = BigInteger::multiply(a, b, algorithms[i]);
+  }
+
+  BigInteger::set_parallelism(4, 100);
+  bool equal = (BigInteger::parallelism() == 4) && (a * a == serial[2] / b * a);
+  for (int i = 0; i < 3; ++i) {
+    equal = equal && (BigInteger::multiply(a, b, algorithms[i]) == serial[i]);
+  }
+  BigInteger::set_parallelism(1);
+
+  std::cout << "4 threads give the serial products for every algorithm\n";
+  std::cout << equal << "\n\n";
+}
+
+void ModularCheck() {
+  std::cout << "powmod / modinv / is_probable_prime:\n";
+  BigInteger prime = pow(BigInteger(2), 607) - 1;
+  BigInteger even = pow(BigInteger(10), 150) * 6;
+  BigInteger base("123456789012345678901234567890123456789");
+
+  std::cout << "3^1000 mod 10^9 + 7, Fermat for 2^607 - 1, an even modulus\n";
+  std::cout << ((powmod(BigInteger(3), BigInteger(1000), BigInteger(1000000007)) == 56888193) &&
+                (powmod(base, prime - 1, prime) == 1) &&
+                (powmod(base, BigInteger(777), even) == pow(base, 777) % even))
+            << "\n";
+
+  ModContext context(prime);
+  BigInteger inverse = modinv(base, prime);
+  std::cout << "modinv and negative exponents\n";
+  std::cout << ((context.multiply(base, inverse) == 1) &&
+                (context.pow(base, BigInteger(-5)) == powmod(inverse, BigInteger(5), prime)) &&
+                (modinv(BigInteger(6), BigInteger(9)) == 0))
+            << "\n";
+
+  std::cout << "2^607 - 1 and 10^9 + 7 are prime, 561 and 2^607 + 1 are not\n";
+  std::cout << (is_probable_prime(prime) && is_probable_prime(BigInteger(1000000007)) &&
+                !is_probable_prime(BigInteger(561)) && !is_probable_prime(prime + 2))
+            << "\n\n";
+}
+
+void BitwiseCheck() {
+  std::cout << "bitwise operators and shifts:\n";
+  BigInteger a("-123456789012345678901234567890");
+  BigInteger b("98765432109876543210");
+
+  std::cout << "two's-complement &, |, ^, ~ on mixed signs\n";
+  std::cout << (((a & b) == BigInteger("20213295392617428010")) &&
+                ((a | b) == BigInteger("-123456788933793542183975452690")) &&
+                ((a ^ b) == BigInteger("-123456788954006837576592880700")) &&
+                (~a == BigInteger("123456789012345678901234567889")))
+            << "\n";
+
+  std::cout << "<< and >> against 2^k, >> rounds down\n";
+  BigInteger power = pow(BigInteger(2), 200);
+  std::cout << (((b << 200) == b * power) && ((b >> 67) == b / pow(BigInteger(2), 67)) &&
+                ((a >> 5) == BigInteger("-3858024656635802465663580247")) && ((BigInteger(-1) >> 1000) == -1))
+            << "\n";
+
+  std::cout << "bit_length, test_bit, popcount\n";
+  std::cout << ((power.bit_length() == 201) && ((power - 1).popcount() == 200) && a.test_bit(1) && !a.test_bit(0) &&
+                a.test_bit(5000) && !b.test_bit(5000) && (BigInteger(0).bit_length() == 0))
+            << "\n\n";
+}
+
+void MemoryResourceCheck() {
+  std::cout << "memory resources:\n";
+  std::string str1;
+  std::string str2;
+  for (int i = 0; i < 3000; ++i) {
+    str1 += std::to_string(rand() % 9 + 1);
+  }
+  for (int i = 0; i < 700; ++i) {
+    str2 += std::to_string(rand() % 9 + 1);
+  }
+  BigInteger x(str1);
+  BigInteger y(str2);
+
+  auto work = [&]() {
+    BigInteger acc;
+    for (int i = 0; i < 20; ++i) {
+      BigInteger q = x / (y + i);
+      acc += q * q % y - x % (y - i);
+    }
+    return acc;
+  };
+
+  BigInteger expected = work();
+  BigInteger result;
+  std::vector<char> buffer(size_t(1) << 24);
+  size_t before = allocations;
+  {
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    std::pmr::memory_resource* previous = BigInteger::set_memory_resource(&arena);
+    result = work();
+    BigInteger::set_memory_resource(previous);
+  }
+  bool no_heap = (allocations == before);
+  std::fill(buffer.begin(), buffer.end(), char(-1));
+
+  std::cout << "division-heavy loop in a monotonic arena touches no heap, result outlives the arena\n";
+  std::cout << (no_heap && (result == expected) && (result.toString() == expected.toString())) << "\n\n";
+}
+
+constexpr auto kMersenne127 = 0x7fffffffffffffffffffffffffffffff_sbi;
+constexpr auto kFactorial30 = 265252859812191058636308480000000_sbi;
+constexpr auto kFolded = kMersenne127 * kMersenne127 % kFactorial30 - kFactorial30 / 1000000007_sbi;
+static_assert(kFolded == StaticBigInteger<8>("201'030'752'150'737'616'622'511'061'250'168"));
+static_assert((kMersenne127 + 1_sbi) / 0x10000000000000000_sbi == 0x8000000000000000_sbi);
+
+void StaticCheck() {
+  std::cout << "compile-time constants:\n";
+  BigInteger mersenne = (BigInteger(1) << 127) - 1;
+  BigInteger factorial = 1;
+  for (int i = 2; i <= 30; ++i) {
+    factorial *= i;
+  }
+
+  std::cout << "_sbi arithmetic folded by the compiler matches BigInteger, _bi literals are folded too\n";
+  std::cout << ((BigInteger(kFolded) == mersenne * mersenne % factorial - factorial / 1000000007) &&
+                (BigInteger(-kMersenne127) == -mersenne) &&
+                (170141183460469231731687303715884105727_bi == mersenne))
+            << "\n\n";
+}
+
+void BatchCheck() {
+  std::cout << "batched multiply / add / powmod:\n";
+  std::vector<BigInteger> big_ints1;
+  std::vector<BigInteger> big_ints2;
+  for (int i = 0; i < 150; ++i) {
+    std::string str1 = (i % 3 == 0 ? "-" : "");
+    std::string str2 = (i % 5 == 0 ? "-" : "");
+    for (int j = 0, digits = 1 + rand() % (i < 100 ? 380 : 1200); j < digits; ++j) {
+      str1 += std::to_string(rand() % 9 + 1);
+    }
+    for (int j = 0, digits = 1 + rand() % 380; j < digits; ++j) {
+      str2 += std::to_string(rand() % 9 + 1);
+    }
+    big_ints1.emplace_back(str1);
+    big_ints2.emplace_back(i % 17 == 0 ? "0" : str2);
+  }
+
+  std::vector<BigInteger> products(big_ints1.size());
+  std::vector<BigInteger> sums(big_ints1.size());
+  BigInteger::multiply_batch(big_ints1, big_ints2, products);
+  BigInteger::add_batch(big_ints1, big_ints2, sums);
+  bool equal = true;
+  for (size_t i = 0; i < big_ints1.size(); ++i) {
+    equal = equal && (products[i] == big_ints1[i] * big_ints2[i]) && (sums[i] == big_ints1[i] + big_ints2[i]);
+  }
+
+  std::vector<BigInteger> aliased = big_ints1;
+  BigInteger::set_parallelism(4, 100);
+  BigInteger::multiply_batch(aliased, big_ints2, aliased);
+  BigInteger::set_parallelism(1);
+  std::cout << "element-wise products and sums of mixed sizes and signs, in place and on 4 threads\n";
+  std::cout << (equal && (aliased == products)) << "\n";
+
+  BigInteger modulus = pow(BigInteger(2), 521) - 1;
+  ModContext context(modulus);
+  std::vector<BigInteger> exponents(big_ints1.begin(), big_ints1.begin() + 20);
+  std::vector<BigInteger> powers(exponents.size());
+  std::vector<BigInteger> modular(big_ints1.size());
+  BigInteger::powmod_batch(big_ints2, exponents, modulus, powers);
+  context.multiply_batch(big_ints1, big_ints2, modular);
+  equal = true;
+  for (size_t i = 0; i < big_ints1.size(); ++i) {
+    equal = equal && (modular[i] == context.multiply(big_ints1[i], big_ints2[i]));
+  }
+  for (size_t i = 0; i < exponents.size(); ++i) {
+    equal = equal && (powers[i] == context.pow(big_ints2[i], exponents[i]));
+  }
+  std::cout << "powmod_batch and ModContext::multiply_batch modulo 2^521 - 1\n";
+  std::cout << equal << "\n\n";
+}
+
 int main() {
 
   std::string str1;
@@ -47,6 +675,22 @@ int main() {
   std::cout << papa << "\n\n";
 
   ComarisonCheck();
+  MultiplyCheck();
+  DivisionCheck();
+  LimbsCheck();
+  StorageCheck();
+  AddSubCheck();
+  CharsCheck();
+  AllocationCheck();
+  GcdCheck();
+  DecimalCheck();
+  FusedCheck();
+  ParallelCheck();
+  ModularCheck();
+  BitwiseCheck();
+  MemoryResourceCheck();
+  StaticCheck();
+  BatchCheck();
 
   std::cout << "123456543234567893456434 + 12345643456787655678976543:\n";
   std::cout << ((BigInteger("123456543234567893456434") + BigInteger("12345643456787655678976543")) == BigInteger("12469100000022223572432977")) << "\n\n";
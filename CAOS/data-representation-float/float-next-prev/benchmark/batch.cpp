@@ -0,0 +1,96 @@
+// Throughput of float_mul called once per value against float_mul_n on whole arrays and the
+// PackedFloats kernel it runs, on random values of a few formats. The array results are checked
+// against the single ones before anything is timed.
+// Build: g++ -std=c++20 -O2 -I../solution batch.cpp ../solution/floats.cpp -o batch
+// Run:   ./batch
+// Add -march=native to let the packed kernels use the widest vectors of the machine.
+#include "PackedFloat.hpp"
+#include "floats.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+constexpr size_t kValues = 4096;
+constexpr size_t kRepeats = 500;
+
+void set_float(Float* flt, int sign, uint64_t exponent, uint64_t mantissa) {
+    float_set_sign(flt, sign);
+    float_set_exponent(flt, &exponent);
+    float_set_mantissa(flt, &mantissa);
+}
+
+bool same(const Float* a, const Float* b) {
+    uint64_t exponent_a = 0, exponent_b = 0, mantissa_a = 0, mantissa_b = 0;
+    float_get_exponent(a, &exponent_a);
+    float_get_exponent(b, &exponent_b);
+    float_get_mantissa(a, &mantissa_a);
+    float_get_mantissa(b, &mantissa_b);
+    return float_get_sign(a) == float_get_sign(b) && exponent_a == exponent_b && mantissa_a == mantissa_b;
+}
+
+template <typename Body> double ns_per_value(Body body) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kRepeats; ++i) {
+        body();
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return ns / (double)(kRepeats * kValues);
+}
+
+int main() {
+    int formats[][2] = {{3, 4}, {5, 10}, {8, 7}, {8, 23}, {11, 52}};
+    std::mt19937_64 rng(7);
+
+    std::cout << "format\tfloat_mul\tfloat_mul_n\tpacked\n";
+    for (auto [exponent_bits, mantissa_bits] : formats) {
+        std::vector<Float> a(kValues), b(kValues), single(kValues), batch(kValues);
+        std::vector<uint32_t> packed_a(kValues), packed_b(kValues), packed_result(kValues);
+        for (size_t i = 0; i < kValues; ++i) {
+            for (Float* flt : {&a[i], &b[i], &single[i], &batch[i]}) {
+                float_init(flt, exponent_bits, mantissa_bits);
+            }
+            uint64_t bits_a = rng(), bits_b = rng();
+            uint64_t max_exponent = (1ull << exponent_bits) - 1, mantissa_mask = (1ull << mantissa_bits) - 1;
+            set_float(&a[i], bits_a >> 63, (bits_a >> mantissa_bits) & max_exponent, bits_a & mantissa_mask);
+            set_float(&b[i], bits_b >> 63, (bits_b >> mantissa_bits) & max_exponent, bits_b & mantissa_mask);
+            packed_a[i] = (uint32_t)(((bits_a >> 63) << (exponent_bits + mantissa_bits)) | (bits_a & ((max_exponent << mantissa_bits) | mantissa_mask)));
+            packed_b[i] = (uint32_t)(((bits_b >> 63) << (exponent_bits + mantissa_bits)) | (bits_b & ((max_exponent << mantissa_bits) | mantissa_mask)));
+        }
+
+        float_mul_n(batch.data(), a.data(), b.data(), kValues);
+        for (size_t i = 0; i < kValues; ++i) {
+            float_mul(&single[i], &a[i], &b[i]);
+            if (!same(&single[i], &batch[i])) {
+                std::cerr << "float_mul_n differs from float_mul for format (" << exponent_bits << ", "
+                          << mantissa_bits << ")\n";
+                return 1;
+            }
+        }
+
+        double single_ns = ns_per_value([&] {
+            for (size_t i = 0; i < kValues; ++i) {
+                float_mul(&single[i], &a[i], &b[i]);
+            }
+        });
+        double batch_ns = ns_per_value([&] { float_mul_n(batch.data(), a.data(), b.data(), kValues); });
+
+        std::cout << "(" << exponent_bits << ", " << mantissa_bits << ")\t" << single_ns << "\t" << batch_ns << "\t";
+        if (PackedFloats::fits(exponent_bits, mantissa_bits)) {
+            PackedFloats packed{exponent_bits, mantissa_bits};
+            std::cout << ns_per_value([&] {
+                packed.mul(packed_a.data(), packed_b.data(), packed_result.data(), kValues);
+            }) << "\n";
+        } else {
+            std::cout << "-\n";
+        }
+
+        for (size_t i = 0; i < kValues; ++i) {
+            for (Float* flt : {&a[i], &b[i], &single[i], &batch[i]}) {
+                float_destroy(flt);
+            }
+        }
+    }
+}
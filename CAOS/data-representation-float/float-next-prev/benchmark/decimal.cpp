@@ -0,0 +1,110 @@
+// Time of float_string and float_parse on a million random values of a few formats, each string
+// checked to read back as its value, with std::to_chars and std::from_chars on float and double
+// for reference. Build it twice to compare FastDecimal with the exact DynNum and BigInt path.
+// Build: g++ -std=c++20 -O2 -I../solution decimal.cpp ../solution/floats.cpp -o decimal
+//        g++ -std=c++20 -O2 -DFLOATS_NO_FAST_DECIMAL -I../solution decimal.cpp ../solution/floats.cpp -o decimal_exact
+// Run:   ./decimal
+#include "floats.h"
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+constexpr size_t kValues = 1000000;
+
+template <typename Body> double ns_per_value(Body body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return ns / (double)kValues;
+}
+
+// Random finite values: any encoding below the exponent of inf and NaN.
+std::vector<uint64_t> random_encodings(int exponent_bits, int mantissa_bits) {
+    std::mt19937_64 rng(11);
+    uint64_t inf_bits = ((1ull << exponent_bits) - 1) << mantissa_bits;
+    std::vector<uint64_t> encodings(kValues);
+    for (uint64_t& bits : encodings) {
+        bits = rng() % inf_bits | (rng() & 1) << (exponent_bits + mantissa_bits);
+    }
+    return encodings;
+}
+
+template <typename T> bool print_reference(const std::vector<uint64_t>& encodings) {
+    std::vector<T> values(kValues);
+    for (size_t i = 0; i < kValues; ++i) {
+        std::memcpy(&values[i], &encodings[i], sizeof(T));
+    }
+    std::vector<std::string> strings(kValues);
+    double to_chars_ns = ns_per_value([&] {
+        char buffer[64];
+        for (size_t i = 0; i < kValues; ++i) {
+            strings[i].assign(buffer, std::to_chars(buffer, buffer + sizeof(buffer), values[i]).ptr);
+        }
+    });
+    std::vector<T> parsed(kValues);
+    double from_chars_ns = ns_per_value([&] {
+        for (size_t i = 0; i < kValues; ++i) {
+            std::from_chars(strings[i].data(), strings[i].data() + strings[i].size(), parsed[i]);
+        }
+    });
+    std::cout << "\t" << to_chars_ns << "\t" << from_chars_ns;
+    return std::memcmp(values.data(), parsed.data(), kValues * sizeof(T)) == 0;
+}
+
+int main() {
+    int formats[][2] = {{5, 10}, {8, 23}, {11, 52}};
+
+    std::cout << "format\tfloat_string ns\tfloat_parse ns\tto_chars ns\tfrom_chars ns\n";
+    for (auto [exponent_bits, mantissa_bits] : formats) {
+        std::vector<uint64_t> encodings = random_encodings(exponent_bits, mantissa_bits);
+        Float value = {};
+        float_init(&value, exponent_bits, mantissa_bits);
+
+        std::vector<std::string> strings(kValues);
+        double string_ns = ns_per_value([&] {
+            char buffer[128];
+            for (size_t i = 0; i < kValues; ++i) {
+                float_set_bits(&value, encodings[i]);
+                strings[i].assign(buffer, float_string(&value, buffer, sizeof(buffer)));
+            }
+        });
+
+        std::vector<uint64_t> parsed(kValues);
+        double parse_ns = ns_per_value([&] {
+            for (size_t i = 0; i < kValues; ++i) {
+                float_parse(&value, strings[i].c_str());
+                parsed[i] = float_get_bits(&value);
+            }
+        });
+
+        for (size_t i = 0; i < kValues; ++i) {
+            if (parsed[i] != encodings[i]) {
+                std::cerr << "'" << strings[i] << "' does not read back in format (" << exponent_bits << ", "
+                          << mantissa_bits << ")\n";
+                return 1;
+            }
+        }
+
+        std::cout << "(" << exponent_bits << ", " << mantissa_bits << ")\t" << string_ns << "\t" << parse_ns;
+        bool reference_ok = true;
+        if (exponent_bits == 8 && mantissa_bits == 23) {
+            reference_ok = print_reference<float>(encodings);
+        } else if (exponent_bits == 11 && mantissa_bits == 52) {
+            reference_ok = print_reference<double>(encodings);
+        } else {
+            std::cout << "\t-\t-";
+        }
+        std::cout << "\n";
+        if (!reference_ok) {
+            std::cerr << "std::from_chars does not read std::to_chars back\n";
+            return 1;
+        }
+        float_destroy(&value);
+    }
+}
@@ -0,0 +1,55 @@
+// Time of DynNum arithmetic on random numbers of a thousand to a hundred thousand digits: a
+// product of two n-digit numbers, a quotient of 2n digits by n to n digits, a reciprocal to n
+// digits and to_string. The quotient is checked against the product it came from.
+// Build: g++ -std=c++20 -O2 -I../solution dynnum.cpp -o dynnum
+// Run:   ./dynnum
+#include "Conversion.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+template <typename Body> double ms(Body body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+DynNum<> random_number(std::mt19937_64& rng, int digits) {
+    std::string text(digits, '0');
+    for (char& c : text) {
+        c = (char)('0' + rng() % 10);
+    }
+    text[0] = (char)('1' + rng() % 9);
+    return DynNum<>(false, digits, text);
+}
+
+int main() {
+    std::mt19937_64 rng(25);
+
+    std::cout << "digits\tmul ms\tdivide ms\treciprocal ms\tto_string ms\n";
+    for (int digits : {1000, 10000, 100000}) {
+        DynNum<> a = random_number(rng, digits);
+        DynNum<> b = random_number(rng, digits);
+
+        DynNum<> product;
+        double mul_ms = ms([&] { product = a * b; });
+
+        DynNum<> quotient;
+        double divide_ms = ms([&] { quotient = DynNum<>::divide(product, b, digits); });
+
+        DynNum<> reciprocal;
+        double reciprocal_ms = ms([&] { reciprocal = b.reciprocal(digits); });
+
+        std::string text;
+        double string_ms = ms([&] { text = product.to_string(); });
+
+        if (quotient != a || (int)text.size() < 2 * digits - 1) {
+            std::cerr << "The quotient of " << digits << " digits does not give back the factor\n";
+            return 1;
+        }
+        std::cout << digits << "\t" << mul_ms << "\t" << divide_ms << "\t" << reciprocal_ms << "\t" << string_ms
+                  << "\n";
+    }
+}
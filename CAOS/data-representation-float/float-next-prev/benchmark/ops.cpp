@@ -0,0 +1,71 @@
+// Nanoseconds per float_add, float_mul, float_div and float_next for formats from 8 to 1024 bits.
+// Build: g++ -std=c++20 -O2 -I../solution ops.cpp ../solution/floats.cpp -o ops
+// Add -DFLOATS_NO_NATIVE to keep every format on LongInt digits.
+#include "floats.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+struct Format {
+    const char* name;
+    int exponent_bits;
+    int mantissa_bits;
+};
+
+constexpr int kValues = 256;
+
+std::vector<Float> random_floats(const Format& format, std::mt19937_64& rng) {
+    std::vector<Float> floats(kValues);
+    for (Float& flt : floats) {
+        float_init(&flt, format.exponent_bits, format.mantissa_bits);
+
+        // Finite values around 1, so that products and quotients stay normal.
+        uint64_t exponent = ((uint64_t)1 << (format.exponent_bits - 1)) - 2 + rng() % 4;
+        std::vector<uint64_t> mantissa((format.mantissa_bits + 63) / 64 + 1);
+        for (uint64_t& word : mantissa) {
+            word = rng();
+        }
+        if (format.mantissa_bits % 64 != 0) {
+            mantissa[format.mantissa_bits / 64] &= ((uint64_t)1 << (format.mantissa_bits % 64)) - 1;
+        }
+        mantissa.back() = 0;
+
+        float_set_sign(&flt, rng() & 1);
+        float_set_exponent(&flt, &exponent);
+        float_set_mantissa(&flt, mantissa.data());
+    }
+    return floats;
+}
+
+template <typename Function> double ns_per_op(size_t repeats, Function function) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < repeats; ++i) {
+        function(i % kValues);
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+           (double)repeats;
+}
+
+int main() {
+    std::mt19937_64 rng(7);
+    Format formats[] = {{"float8", 3, 4},     {"float32", 8, 23},    {"float64", 11, 52},
+                        {"float80", 15, 64},  {"float128", 15, 112}, {"float1024", 15, 1008}};
+
+    std::cout << "format\tadd ns\tmul ns\tdiv ns\tnext ns\n";
+    for (const Format& format : formats) {
+        std::vector<Float> a = random_floats(format, rng);
+        std::vector<Float> b = random_floats(format, rng);
+        Float result = {};
+        float_init(&result, format.exponent_bits, format.mantissa_bits);
+        size_t repeats = format.mantissa_bits > 128 ? 20000 : 1000000;
+
+        double add = ns_per_op(repeats, [&](size_t i) { float_add(&result, &a[i], &b[i]); });
+        double mul = ns_per_op(repeats, [&](size_t i) { float_mul(&result, &a[i], &b[i]); });
+        double div = ns_per_op(repeats, [&](size_t i) { float_div(&result, &a[i], &b[i]); });
+        double next = ns_per_op(repeats, [&](size_t i) { float_next(&a[i]); });
+        std::cout << format.name << "\t" << add << "\t" << mul << "\t" << div << "\t" << next << "\n";
+    }
+}
@@ -0,0 +1,102 @@
+// Throughput of float_add, float_sub, float_mul and float_div on the random cases of
+// tests_general.cpp, read from the test source so that the two never drift apart. Every case
+// is checked against its expected result before it is timed.
+// Build: g++ -std=c++20 -O2 -I../solution random_suites.cpp ../solution/floats.cpp -o random_suites
+// Run:   ./random_suites [path to tests_general.cpp]
+// Add -DFLOATS_NO_NATIVE to keep every format on LongInt digits.
+#include "floats.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using FloatBinOp = void(Float* result, const Float* a, const Float* b);
+
+struct Case {
+    int exponent_bits;
+    int mantissa_bits;
+    Float a, b, expected, result;
+};
+
+constexpr size_t kRepeats = 200000;
+
+void set_float(Float* flt, int sign, uint64_t exponent, uint64_t mantissa) {
+    float_set_sign(flt, sign);
+    float_set_exponent(flt, &exponent);
+    float_set_mantissa(flt, &mantissa);
+}
+
+bool same(const Float* a, const Float* b) {
+    uint64_t exponent_a = 0, exponent_b = 0, mantissa_a = 0, mantissa_b = 0;
+    float_get_exponent(a, &exponent_a);
+    float_get_exponent(b, &exponent_b);
+    float_get_mantissa(a, &mantissa_a);
+    float_get_mantissa(b, &mantissa_b);
+    return float_get_sign(a) == float_get_sign(b) && exponent_a == exponent_b && mantissa_a == mantissa_b;
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "../tests/tests_general.cpp";
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "cannot open " << path << "\n";
+        return 1;
+    }
+    std::stringstream source;
+    source << file.rdbuf();
+    std::string text = source.str();
+
+    std::map<std::string, FloatBinOp*> ops = {
+        {"float_add", float_add}, {"float_sub", float_sub}, {"float_mul", float_mul}, {"float_div", float_div}};
+
+    // test_bin_op(op, e, m, "a", sign, exponent, mantissa, "b", ..., "expected", ...).
+    std::string value = R"(\s*"[^"]*",\s*(\d),\s*(0x[0-9a-fA-F]+),\s*(0x[0-9a-fA-F]+))";
+    std::regex pattern(R"(test_bin_op\((float_\w+),\s*(\d+),\s*(\d+),)" + value + "," + value + "," + value);
+
+    std::map<std::string, std::vector<Case>> cases;
+    for (auto it = std::sregex_iterator(text.begin(), text.end(), pattern); it != std::sregex_iterator(); ++it) {
+        const std::smatch& match = *it;
+        if (ops.count(match[1]) == 0) {
+            continue;
+        }
+
+        Case& test = cases[match[1]].emplace_back();
+        test.exponent_bits = std::stoi(match[2]);
+        test.mantissa_bits = std::stoi(match[3]);
+        Float* floats[] = {&test.a, &test.b, &test.expected};
+        for (int i = 0; i < 3; ++i) {
+            float_init(floats[i], test.exponent_bits, test.mantissa_bits);
+            set_float(floats[i], std::stoi(match[4 + 3 * i]), std::stoull(match[5 + 3 * i], nullptr, 16),
+                      std::stoull(match[6 + 3 * i], nullptr, 16));
+        }
+        float_init(&test.result, test.exponent_bits, test.mantissa_bits);
+    }
+
+    std::cout << "op\tcases\tns/op\n";
+    for (auto& [name, op_cases] : cases) {
+        FloatBinOp* op = ops[name];
+        for (Case& test : op_cases) {
+            op(&test.result, &test.a, &test.b);
+            if (!same(&test.result, &test.expected)) {
+                std::cerr << name << " gives a wrong result for a case of format (" << test.exponent_bits << ", "
+                          << test.mantissa_bits << ")\n";
+                return 1;
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < kRepeats; ++i) {
+            for (Case& test : op_cases) {
+                op(&test.result, &test.a, &test.b);
+            }
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        std::cout << name << "\t" << op_cases.size() << "\t" << ns / (double)(kRepeats * op_cases.size()) << "\n";
+    }
+}
@@ -0,0 +1,63 @@
+// Time of a sweep over every value of a few small formats: float_next from -inf up, FloatValues
+// stepping the encodings, and FloatValues::sweep on every hardware thread. Each value goes
+// through float_get_bits so that the sweeps do the same work and cannot be optimized out.
+// Build: g++ -std=c++20 -O2 -I../solution sweep.cpp ../solution/floats.cpp -o sweep
+// Run:   ./sweep
+#include "FloatValues.hpp"
+#include "floats.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+template <typename Body> double ms(Body body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    int formats[][2] = {{4, 3}, {5, 10}, {8, 7}, {8, 15}};
+
+    std::cout << "format\tvalues\tfloat_next ms\trange ms\tsweep ms (" << std::thread::hardware_concurrency()
+              << " threads)\n";
+    for (auto [exponent_bits, mantissa_bits] : formats) {
+        FloatValues values(exponent_bits, mantissa_bits);
+        uint64_t inf_bits = (((uint64_t)1 << exponent_bits) - 1) << mantissa_bits;
+        uint64_t sign_bit = (uint64_t)1 << (exponent_bits + mantissa_bits);
+
+        // -inf to +inf takes all but the NaNs, which float_next does not reach.
+        double next_ms = ms([&] {
+            Float value = {};
+            float_init(&value, exponent_bits, mantissa_bits);
+            float_set_bits(&value, sign_bit | inf_bits);
+            while (float_get_bits(&value) != inf_bits) {
+                float_next(&value);
+            }
+            float_destroy(&value);
+        });
+
+        uint64_t range_sum = 0;
+        double range_ms = ms([&] {
+            for (const Float& value : values) {
+                range_sum += float_get_bits(&value);
+            }
+        });
+
+        std::atomic<uint64_t> sweep_sum = 0;
+        double sweep_ms = ms([&] {
+            values.sweep([&](const Float& value) {
+                sweep_sum.fetch_add(float_get_bits(&value), std::memory_order_relaxed);
+            });
+        });
+
+        if (range_sum != sweep_sum || range_sum != values.size() * (values.size() - 1) / 2) {
+            std::cerr << "The sweeps of format (" << exponent_bits << ", " << mantissa_bits << ") differ\n";
+            return 1;
+        }
+        std::cout << "(" << exponent_bits << ", " << mantissa_bits << ")\t" << values.size() << "\t" << next_ms
+                  << "\t" << range_ms << "\t" << sweep_ms << "\n";
+    }
+}
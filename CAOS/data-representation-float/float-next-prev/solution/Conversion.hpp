@@ -1,23 +1,36 @@
 #pragma once
 
 #include "DynNum.hpp"
-#include <sstream>
+#include <algorithm>
+#include <charconv>
+#include <string>
 
 class Conversion {
   public:
     static std::string string(const DynNum<>& input_num, int precision = -1) {
-        std::stringstream result;
-
-        if (input_num.sign)
-            result << '-';
-
-        int digits = (int)input_num.digits.size();
+        int digits = input_num.digit_count();
         if (precision > 0 && digits > precision) {
             digits = precision;
         }
 
-        int trailing_zeroes = std::max(0, input_num.dot_index - digits);
-        int leading_zeroes = input_num.get_leading_zeroes();
+        std::string characters(digits, '0');
+        input_num.write_digits(characters.data(), digits);
+
+        std::string result(digits + max_decoration, '\0');
+        result.resize(write(input_num.sign, characters.data(), digits, input_num.dot_index(), result.data()));
+        return result;
+    }
+
+    // The layout of string() for count digits given as characters, worth 0.d1d2... * 10^dot_index:
+    // "12.5" and "0.5" as they are, "15E2" for trailing zeroes and "0.123E-2" for leading ones.
+    // out needs room for count + max_decoration characters; returns how many were written.
+    static int write(bool sign, const char* digits, int count, int dot_index, char* out) {
+        char* p = out;
+        if (sign)
+            *p++ = '-';
+
+        int trailing_zeroes = std::max(0, dot_index - count);
+        int leading_zeroes = std::max(0, -dot_index);
         int dot_move = 0;
 
         if (trailing_zeroes > 0)
@@ -25,32 +38,31 @@ class Conversion {
         if (leading_zeroes > 0)
             dot_move = leading_zeroes;
 
-        int dot_index = input_num.dot_index + dot_move;
+        dot_index += dot_move;
 
         if (dot_index > 0) {
-            for (int i = 0; i < dot_index; i++) {
-                result << input_num.digits[i];
-            }
+            p = std::copy(digits, digits + dot_index, p);
         } else {
-            result << '0';
+            *p++ = '0';
         }
 
-        if (dot_index < digits) {
-            result << '.';
-
-            for (int i = dot_index; i < digits; i++) {
-                result << input_num.digits[i];
-            }
+        if (dot_index < count) {
+            *p++ = '.';
+            p = std::copy(digits + dot_index, digits + count, p);
         }
 
         if (dot_move != 0) {
-            result << "E" << -dot_move;
+            *p++ = 'E';
+            p = std::to_chars(p, p + max_decoration, -dot_move).ptr;
         }
 
-        return result.str();
+        return (int)(p - out);
     }
+
+    // Sign, "0.", 'E' and the exponent of an int.
+    static constexpr int max_decoration = 16;
 };
 
 template <typename T> std::string DynNum<T>::to_string(int precision) const {
     return Conversion::string(*this, precision);
-}
\ No newline at end of file
+}
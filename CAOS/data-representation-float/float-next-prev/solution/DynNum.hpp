@@ -1,7 +1,11 @@
 #pragma once
-#include <cctype>
-#include <deque>
+#include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
 
 template <int _radix = 10> struct Digit {
     static constexpr int radix = _radix;
@@ -81,8 +85,34 @@ template <typename T, int radix> T& operator<<(T& stream, const Digit<radix>& di
     return stream;
 }
 
+// sign * limbs * radix^exponent, with the digits packed limb_digits to a limb, lowest limb first.
+// Normalized numbers have no zero limbs at either end and zero is unsigned, so that a value
+// takes a ninth of the limbs it would take as one decimal Digit each.
 template <typename Digit = Digit<>> class DynNum {
   public:
+    using Limb = uint32_t;
+    using Limbs = std::vector<Limb>;
+
+    static constexpr int radix = Digit::radix;
+
+    // As many digits as stay within 10^9, so that a product of two limbs plus two carries fits
+    // 64 bits: nine for decimal, seven for hexadecimal.
+    static constexpr int limb_digits = [] {
+        int digits = 0;
+        for (uint64_t power = radix; power <= 1000000000; power *= radix) {
+            digits++;
+        }
+        return digits;
+    }();
+
+    static constexpr Limb limb_base = [] {
+        Limb power = 1;
+        for (int i = 0; i < limb_digits; i++) {
+            power *= radix;
+        }
+        return power;
+    }();
+
     DynNum() = default;
 
     explicit DynNum(const char* number) {
@@ -91,301 +121,516 @@ template <typename Digit = Digit<>> class DynNum {
         }
     }
 
-    DynNum(bool sign, int dot_index, std::deque<Digit> digits)
-        : sign(sign), dot_index(dot_index), digits(std::move(digits)) {}
-
-    static DynNum one;
-
-    bool operator==(const DynNum& other) const {
-        return sign == other.sign && dot_index == other.dot_index && digits == other.digits;
+    // 0.d1d2... * radix^dot_index for digits given as characters.
+    DynNum(bool sign, int dot_index, std::string_view digits)
+        : sign(sign), exponent(dot_index - (int)digits.size()), limbs(pack(digits)) {
+        normalize();
     }
 
+    bool operator==(const DynNum& other) const { return sign == other.sign && compare(*this, other) == 0; }
+
     bool operator!=(const DynNum& other) const { return !(*this == other); }
 
     bool operator>(const DynNum& other) const {
-        if (other.is_zero()) {
-            if (is_zero()) {
-                return false;
-            }
-            return !sign;
-        }
-
-        if (is_zero()) {
-            return other.sign;
-        }
-
         if (sign != other.sign) {
             return !sign;
         }
-
-        if (dot_index != other.dot_index) {
-            return (dot_index > other.dot_index) ^ sign;
-        }
-
-        for (int i = 0; i < digits.size() || i < other.digits.size(); i++) {
-            Digit a = i < digits.size() ? digits[i] : Digit(0);
-            Digit b = i < other.digits.size() ? other.digits[i] : Digit(0);
-
-            if (a != b) {
-                return (a > b) ^ sign;
-            }
-        }
-
-        return false;
+        int order = compare(*this, other);
+        return sign ? order < 0 : order > 0;
     }
 
-    DynNum& operator+=(const DynNum& b) {
-        DynNum& a = *this;
-        if (is_zero()) {
-            a = b;
-            return a;
-        }
-
-        if (b.is_zero())
-            return a;
-
-        if (a.sign != b.sign) {
-            a.sign = !sign;
-            bool swap = (*this < b) ^ a.sign;
-            a.sign = !b.sign;
-            if (swap) {
-                auto result = b;
-                result += *this;
-                *this = result;
-                return *this;
-            }
-        }
-
-        int max_digit_index = std::max(a.dot_index, b.dot_index);
-        int min_digit_index = std::min(a.dot_index - (int)a.digits.size(), b.dot_index - (int)b.digits.size());
-
-        // Prepare digits
-
-        while (a.dot_index < max_digit_index) {
-            a.digits.push_front(Digit(0));
-            a.dot_index++;
-        }
+    bool operator<(const DynNum& other) const { return other > *this; }
 
-        while (min_digit_index < a.dot_index - (int)a.digits.size()) {
-            a.digits.push_back(Digit(0));
-        }
+    bool operator<=(const DynNum& other) const { return !(*this > other); }
 
-        // Invariants:
-        // - a.sign == b.sign || abs(a) >= abs(b)
-        // - a.dot_index >= b.dot_index
-        // - a.digits.size() >= b.digits.size()
-        // - a digits cover b digits
+    bool operator>=(const DynNum& other) const { return !(other > *this); }
 
-        bool carry = false;
-        for (int i = b.digits.size() - 1; i >= 0; i--) {
-            int a_index = i + a.dot_index - b.dot_index;
-            if (a.sign == b.sign) {
-                carry = a.digits[a_index].add(b.digits[i], carry);
-            } else {
-                carry = a.digits[a_index].sub(b.digits[i], carry);
-            }
+    DynNum& operator+=(const DynNum& other) {
+        if (other.is_zero()) {
+            return *this;
         }
-
-        if (carry) {
-            for (int i = a.dot_index - b.dot_index - 1; i >= 0 && carry; i--) {
-                if (a.sign == b.sign) {
-                    carry = a.digits[i].add(Digit(0), carry);
-                } else {
-                    carry = a.digits[i].sub(Digit(0), carry);
-                }
-            }
+        if (is_zero()) {
+            return *this = other;
         }
 
-        if (carry) {
-            assert(a.sign == b.sign);
-            a.digits.push_front(Digit(1));
-            a.dot_index++;
+        int common = std::min(exponent, other.exponent);
+        Limbs a = shift_limbs(limbs, exponent - common);
+        Limbs b = shift_limbs(other.limbs, other.exponent - common);
+        if (sign == other.sign) {
+            add_limbs(a, b, 0);
+        } else if (compare_limbs(a, b) >= 0) {
+            sub_limbs(a, b);
+        } else {
+            sub_limbs(b, a);
+            a = std::move(b);
+            sign = other.sign;
         }
 
+        limbs = std::move(a);
+        exponent = common;
         normalize();
         return *this;
     }
 
-    DynNum partition(int begin, int end) const {
-        DynNum result;
-        begin = std::max(0, begin);
-        end = std::min(end, (int)digits.size());
-        if (begin < 0 && end < 0 || begin >= end)
-            return result;
+    DynNum operator+(const DynNum& other) const {
+        DynNum result = *this;
+        result += other;
+        return result;
+    }
 
-        for (int i = begin; i < end; i++) {
-            result.digits.push_back(digits[i]);
-        }
-        result.dot_index = result.digits.size();
-        result.normalize();
+    DynNum& operator-=(const DynNum& other) {
+        *this += -other;
+        return *this;
+    }
 
+    DynNum operator-(const DynNum& other) const {
+        DynNum result = *this;
+        result -= other;
         return result;
     }
 
-    static DynNum square_mul(const DynNum& a, const DynNum& b) {
-        if (a.is_zero() || b.is_zero()) {
-            return DynNum();
-        }
+    DynNum operator-() const {
+        DynNum result = *this;
+        result.sign = !sign && !is_zero();
+        return result;
+    }
 
+    DynNum operator*(const DynNum& other) const {
         DynNum result;
-        DynNum tmp;
-
-        for (int i = 0; i < b.digits.size(); i++) {
-            for (int j = 0; j < a.digits.size(); j++) {
-                auto power = b.dot_index - i + a.dot_index - j;
-                int product = b.digits[i].value * a.digits[j].value;
-
-                tmp.digits.clear();
-                tmp.digits.push_back(Digit(product / Digit::radix));
-                tmp.digits.push_back(Digit(product));
-                tmp.dot_index = power;
-                tmp.normalize();
-                result += tmp;
-            }
+        result.limbs = mul_limbs(limbs, other.limbs);
+        result.exponent = exponent + other.exponent;
+        result.sign = sign ^ other.sign;
+        result.normalize();
+        return result;
+    }
+
+    DynNum& operator*=(const DynNum& other) {
+        *this = *this * other;
+        return *this;
+    }
+
+    // a / b to precision significant digits, rounded toward zero: the integer quotient of the
+    // limbs, with a scaled until it has that many digits.
+    static DynNum divide(const DynNum& a, const DynNum& b, int precision) {
+        assert(!b.is_zero() && precision > 0);
+        if (a.is_zero()) {
+            return {};
         }
 
+        int scale = std::max(0, precision + b.limb_digit_count() - a.limb_digit_count());
+        DynNum result;
+        result.limbs = div_limbs(shift_limbs(a.limbs, scale), b.limbs);
+        result.exponent = a.exponent - b.exponent - scale;
         result.sign = a.sign ^ b.sign;
         result.normalize();
+        result.truncate(precision);
         return result;
     }
 
-    static DynNum karatsuba_mul(const DynNum& a, const DynNum& b) {
-        if (a.is_zero() || b.is_zero())
-            return {};
-        if (a == one)
-            return b;
-        if (b == one)
-            return a;
-
-        if (a.digits.size() == 1 && b.digits.size() == 1) {
-            int product = a.digits[0].value * b.digits[0].value;
-            DynNum result = {
-                (bool)(a.sign ^ b.sign), a.dot_index + b.dot_index, {Digit(product / Digit::radix), Digit(product)}};
-            result.normalize();
-            return result;
+    DynNum reciprocal(int precision) const { return divide(DynNum(false, 1, "1"), *this, precision); }
+
+    // Keeps the leading precision digits, rounding toward zero.
+    DynNum& truncate(int precision) {
+        assert(precision > 0);
+        int dropped = limb_digit_count() - precision;
+        if (dropped <= 0) {
+            return *this;
         }
+        limbs.erase(limbs.begin(), limbs.begin() + dropped / limb_digits);
+        exponent += dropped / limb_digits * limb_digits;
+        limbs[0] -= limbs[0] % power(dropped % limb_digits);
+        normalize();
+        return *this;
+    }
 
-        int size = std::max(a.digits.size(), b.digits.size());
-        int partition_l_size = size / 2;
-        int partition_r_size = (size + 1) / 2;
+    DynNum& binpow(int power) {
+        assert(power >= 0);
 
-        int partition_a = a.digits.size() - partition_r_size;
-        int partition_b = b.digits.size() - partition_r_size;
+        DynNum res(false, 1, "1");
 
-        DynNum al = a.partition(partition_a - partition_l_size, partition_a);
-        DynNum ar = a.partition(partition_a, partition_a + partition_r_size);
+        while (power) {
+            if (power & 1) {
+                res *= *this;
+                --power;
+            } else {
+                *this *= *this;
+                power >>= 1;
+            }
+        }
+        *this = res;
+        return *this;
+    }
 
-        DynNum bl = b.partition(partition_b - partition_l_size, partition_b);
-        DynNum br = b.partition(partition_b, partition_b + partition_r_size);
+    bool is_zero() const { return limbs.empty(); }
 
-        DynNum P1 = al * bl;
-        DynNum P2 = ar * br;
+    // The number is 0.d1d2... * radix^dot_index() with digit_count() significant digits.
+    int dot_index() const { return exponent + limb_digit_count(); }
+
+    int digit_count() const {
+        if (is_zero()) {
+            return 0;
+        }
+        int trailing = 0;
+        for (Limb low = limbs[0]; low % radix == 0; low /= radix) {
+            trailing++;
+        }
+        return limb_digit_count() - trailing;
+    }
 
-        al += ar;
-        bl += br;
+    // The i-th significant digit, counting from the leading one.
+    Digit digit(int i) const {
+        assert(i >= 0 && i < digit_count());
+        int position = limb_digit_count() - 1 - i;
+        return Digit((int)(limbs[position / limb_digits] / power(position % limb_digits) % radix));
+    }
 
-        DynNum P3 = al * bl;
+    // The leading count significant digits as characters: 0-9, then A-Z past ten.
+    void write_digits(char* out, int count) const {
+        assert(count >= 0 && count <= digit_count());
+        char limb_characters[limb_digits];
+        for (int i = (int)limbs.size() - 1; i >= 0 && count > 0; i--) {
+            int width = i + 1 == (int)limbs.size() ? limb_width(limbs[i]) : limb_digits;
+            Limb limb = limbs[i];
+            for (int j = width - 1; j >= 0; j--) {
+                int digit = (int)(limb % radix);
+                limb_characters[j] = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+                limb /= radix;
+            }
+            int written = std::min(width, count);
+            out = std::copy(limb_characters, limb_characters + written, out);
+            count -= written;
+        }
+    }
 
-        P3 -= P1;
-        P3 -= P2;
+    int get_trailing_zeroes() const { return std::max(0, dot_index() - digit_count()); }
 
-        P1.dot_index += 2 * partition_r_size;
-        P3.dot_index += partition_r_size;
+    int get_leading_zeroes() const { return std::max(0, -dot_index()); }
 
-        P1 += P2;
-        P1 += P3;
+    void normalize() {
+        trim(limbs);
+        size_t zero_limbs = 0;
+        while (zero_limbs < limbs.size() && limbs[zero_limbs] == 0) {
+            zero_limbs++;
+        }
+        limbs.erase(limbs.begin(), limbs.begin() + zero_limbs);
+        exponent += (int)zero_limbs * limb_digits;
 
-        P1.dot_index += a.dot_index + b.dot_index - a.digits.size() - b.digits.size();
-        P1.sign = a.sign ^ b.sign;
-        P1.normalize();
-        return P1;
+        if (is_zero()) {
+            sign = false;
+            exponent = 0;
+        }
     }
 
-    DynNum operator*(const DynNum& other) {
-        if (digits.size() * other.digits.size() > 500) {
-            return karatsuba_mul(*this, other);
+    std::string to_string(int precision = -1) const;
+
+    bool sign = false;
+
+  private:
+    // Below this many limbs in the shorter operand Karatsuba costs more than it saves.
+    static constexpr int karatsuba_threshold = 32;
+    // Below this many limbs in the divisor or the quotient long division beats the Newton
+    // reciprocal, which costs a few multiplications of the divisor's size.
+    static constexpr int newton_threshold = 96;
+
+    static constexpr Limb power(int digits) {
+        Limb result = 1;
+        for (int i = 0; i < digits; i++) {
+            result *= radix;
         }
-        return square_mul(*this, other);
+        return result;
     }
 
-    DynNum& operator*=(const DynNum& other) {
-        *this = *this * other;
-        return *this;
+    static int limb_width(Limb limb) {
+        int width = 0;
+        for (; limb != 0; limb /= radix) {
+            width++;
+        }
+        return width;
     }
 
-    DynNum operator+(const DynNum& other) const {
-        DynNum result = *this;
-        result += other;
-        return result;
+    // Digits of the integer the limbs make, trailing zeroes of the lowest limb included.
+    int limb_digit_count() const {
+        return is_zero() ? 0 : ((int)limbs.size() - 1) * limb_digits + limb_width(limbs.back());
     }
 
-    DynNum& operator-=(const DynNum& other) {
-        *this += -other;
-        return *this;
+    // |a| <=> |b| as -1, 0 or 1.
+    static int compare(const DynNum& a, const DynNum& b) {
+        if (a.is_zero() || b.is_zero()) {
+            return (int)!a.is_zero() - (int)!b.is_zero();
+        }
+        if (a.dot_index() != b.dot_index()) {
+            return a.dot_index() < b.dot_index() ? -1 : 1;
+        }
+        int common = std::min(a.exponent, b.exponent);
+        return compare_limbs(shift_limbs(a.limbs, a.exponent - common), shift_limbs(b.limbs, b.exponent - common));
     }
 
-    DynNum operator-(const DynNum& other) const {
-        DynNum result = *this;
-        result -= other;
+    static Limbs pack(std::string_view digits) {
+        Limbs result((digits.size() + limb_digits - 1) / limb_digits, 0);
+        for (size_t i = 0; i < digits.size(); i++) {
+            int digit = char_to_digit_radix(digits[i]);
+            assert(digit >= 0);
+            size_t position = digits.size() - 1 - i;
+            result[position / limb_digits] += (Limb)digit * power((int)(position % limb_digits));
+        }
         return result;
     }
 
-    int get_trailing_zeroes() const { return std::max(0, dot_index - (int)digits.size()); }
-
-    int get_leading_zeroes() const { return std::max(0, -dot_index); }
-
-    bool operator<(const DynNum& other) const { return other > *this; }
+    static void trim(Limbs& a) {
+        while (!a.empty() && a.back() == 0) {
+            a.pop_back();
+        }
+    }
 
-    bool operator<=(const DynNum& other) const { return !(*this > other); }
+    static int compare_limbs(const Limbs& a, const Limbs& b) {
+        if (a.size() != b.size()) {
+            return a.size() < b.size() ? -1 : 1;
+        }
+        for (size_t i = a.size(); i-- > 0;) {
+            if (a[i] != b[i]) {
+                return a[i] < b[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
 
-    bool operator>=(const DynNum& other) const { return !(other > *this); }
+    // a * radix^digits.
+    static Limbs shift_limbs(const Limbs& a, int digits) {
+        Limbs result(digits / limb_digits, 0);
+        result.insert(result.end(), a.begin(), a.end());
+        Limb factor = power(digits % limb_digits);
+        if (factor != 1) {
+            uint64_t carry = 0;
+            for (size_t i = digits / limb_digits; i < result.size(); i++) {
+                uint64_t cur = (uint64_t)result[i] * factor + carry;
+                result[i] = (Limb)(cur % limb_base);
+                carry = cur / limb_base;
+            }
+            if (carry != 0) {
+                result.push_back((Limb)carry);
+            }
+        }
+        return result;
+    }
 
-    DynNum operator-() const { return {!sign, dot_index, digits}; }
+    // a += b * limb_base^offset.
+    static void add_limbs(Limbs& a, const Limbs& b, size_t offset) {
+        if (a.size() < offset + b.size()) {
+            a.resize(offset + b.size(), 0);
+        }
+        Limb carry = 0;
+        for (size_t i = 0; i < b.size() || carry; i++) {
+            if (offset + i == a.size()) {
+                a.push_back(0);
+            }
+            Limb sum = a[offset + i] + (i < b.size() ? b[i] : 0) + carry;
+            carry = sum >= limb_base;
+            a[offset + i] = carry ? sum - limb_base : sum;
+        }
+        trim(a);
+    }
 
-    bool is_zero() const { return digits.size() == 0; }
+    // a -= b for a >= b.
+    static void sub_limbs(Limbs& a, const Limbs& b) {
+        Limb borrow = 0;
+        for (size_t i = 0; i < b.size() || borrow; i++) {
+            assert(i < a.size());
+            Limb subtrahend = (i < b.size() ? b[i] : 0) + borrow;
+            borrow = a[i] < subtrahend;
+            a[i] = borrow ? a[i] + limb_base - subtrahend : a[i] - subtrahend;
+        }
+        trim(a);
+    }
 
-    DynNum& binpow(int power) {
-        assert(power >= 0);
+    static Limbs mul_limbs(const Limbs& a, const Limbs& b) {
+        if (a.size() < b.size()) {
+            return mul_limbs(b, a);
+        }
+        if (b.empty()) {
+            return {};
+        }
 
-        DynNum res(false, 1, {Digit(1)});
+        size_t n = a.size(), m = b.size();
+        if (m < karatsuba_threshold) {
+            Limbs out(n + m, 0);
+            for (size_t i = 0; i < m; ++i) {
+                uint64_t carry = 0;
+                for (size_t j = 0; j < n; ++j) {
+                    uint64_t cur = (uint64_t)a[j] * b[i] + out[i + j] + carry;
+                    out[i + j] = (Limb)(cur % limb_base);
+                    carry = cur / limb_base;
+                }
+                out[i + n] = (Limb)carry;
+            }
+            trim(out);
+            return out;
+        }
 
-        while (power) {
-            if (power & 1) {
-                res *= *this;
-                --power;
-            } else {
-                *this *= *this;
-                power >>= 1;
+        // Far from balanced: a is cut into pieces of m limbs, each a balanced product.
+        if (2 * m <= n) {
+            Limbs out;
+            for (size_t i = 0; i < n; i += m) {
+                Limbs piece(a.begin() + i, a.begin() + std::min(n, i + m));
+                trim(piece);
+                add_limbs(out, mul_limbs(piece, b), i);
             }
+            return out;
         }
-        *this = res;
-        return *this;
+
+        // a = a1 * B^half + a0, b = b1 * B^half + b0 and
+        // a * b = z2 * B^(2 half) + ((a0 + a1) * (b0 + b1) - z2 - z0) * B^half + z0.
+        size_t half = (n + 1) / 2;
+        Limbs a0(a.begin(), a.begin() + half), a1(a.begin() + half, a.end());
+        Limbs b0(b.begin(), b.begin() + half), b1(b.begin() + half, b.end());
+        trim(a0);
+        trim(b0);
+
+        Limbs out = mul_limbs(a0, b0);
+        Limbs z2 = mul_limbs(a1, b1);
+        add_limbs(a0, a1, 0);
+        add_limbs(b0, b1, 0);
+        Limbs middle = mul_limbs(a0, b0);
+        sub_limbs(middle, out);
+        sub_limbs(middle, z2);
+        add_limbs(out, middle, half);
+        add_limbs(out, z2, 2 * half);
+        return out;
     }
 
-    void normalize() {
-        while (digits.size() > 0 && digits.front() == Digit(0)) {
-            digits.pop_front();
-            dot_index--;
+    // floor(a / b) for b != 0.
+    static Limbs div_limbs(const Limbs& a, const Limbs& b) {
+        assert(!b.empty());
+        if (compare_limbs(a, b) < 0) {
+            return {};
+        }
+        if (b.size() < newton_threshold || a.size() - b.size() < newton_threshold) {
+            return long_division(a, b);
         }
 
-        while (digits.size() > 0 && digits.back() == Digit(0)) {
-            digits.pop_back();
+        // Both are shifted until b has at least as many limbs as the quotient, so that a fits in
+        // twice the limbs of b and one reciprocal of b's precision gives the whole quotient.
+        size_t shift = a.size() + 1 > 2 * b.size() ? a.size() + 1 - 2 * b.size() : 0;
+        Limbs divisor(shift, 0);
+        divisor.insert(divisor.end(), b.begin(), b.end());
+        Limbs product = mul_limbs(a, reciprocal_limbs(divisor));
+        size_t dropped = std::min(product.size(), 2 * divisor.size() - shift);
+        Limbs quotient(product.begin() + dropped, product.end());
+
+        // The reciprocal is off by a few units at most, and so is the quotient.
+        const Limbs one = {1};
+        product = mul_limbs(quotient, b);
+        while (compare_limbs(product, a) > 0) {
+            sub_limbs(quotient, one);
+            sub_limbs(product, b);
+        }
+        Limbs remainder = a;
+        sub_limbs(remainder, product);
+        while (compare_limbs(remainder, b) >= 0) {
+            add_limbs(quotient, one, 0);
+            sub_limbs(remainder, b);
         }
+        return quotient;
+    }
 
-        if (is_zero()) {
-            sign = false;
-            dot_index = 0;
+    // Within a few units of B^(2 n) / b for n limbs of b: Newton's x (2 - b x) on the
+    // reciprocal of the leading half of b, which doubles its correct limbs.
+    static Limbs reciprocal_limbs(const Limbs& b) {
+        size_t n = b.size();
+        if (n < newton_threshold) {
+            Limbs power(2 * n + 1, 0);
+            power.back() = 1;
+            return long_division(power, b);
         }
+
+        // The leading limbs give B^(2 n) / b to a relative error of about B^(1 - half), which
+        // Newton's step squares to below one unit.
+        size_t half = n / 2 + 2;
+        Limbs x(n - half, 0);
+        Limbs leading = reciprocal_limbs(Limbs(b.end() - half, b.end()));
+        x.insert(x.end(), leading.begin(), leading.end());
+
+        Limbs square = mul_limbs(b, mul_limbs(x, x));
+        Limbs correction(square.begin() + std::min(square.size(), 2 * n), square.end());
+        Limbs result = x;
+        add_limbs(result, x, 0);
+        sub_limbs(result, correction);
+        return result;
     }
 
-    std::string to_string(int precision = -1) const;
+    // Knuth's algorithm D in base limb_base, with the divisor scaled until its top limb is at
+    // least half the base, so that every estimated quotient limb is at most two too large.
+    static Limbs long_division(const Limbs& a, const Limbs& b) {
+        size_t n = a.size(), m = b.size();
+        Limbs quotient(n - m + 1, 0);
+        if (m == 1) {
+            uint64_t rest = 0;
+            for (size_t i = n; i-- > 0;) {
+                uint64_t cur = rest * limb_base + a[i];
+                quotient[i] = (Limb)(cur / b[0]);
+                rest = cur % b[0];
+            }
+            trim(quotient);
+            return quotient;
+        }
 
-    bool sign = false;
-    int dot_index = 0;
-    std::deque<Digit> digits{};
+        Limb scale = limb_base / (b[m - 1] + 1);
+        auto scaled = [scale](const Limbs& x, size_t size) {
+            Limbs result(size, 0);
+            uint64_t carry = 0;
+            for (size_t i = 0; i < x.size(); i++) {
+                uint64_t cur = (uint64_t)x[i] * scale + carry;
+                result[i] = (Limb)(cur % limb_base);
+                carry = cur / limb_base;
+            }
+            if (carry != 0) {
+                result[x.size()] = (Limb)carry;
+            }
+            return result;
+        };
+        Limbs u = scaled(a, n + 1);
+        Limbs v = scaled(b, m);
+
+        for (size_t j = n - m + 1; j-- > 0;) {
+            uint64_t top = (uint64_t)u[j + m] * limb_base + u[j + m - 1];
+            uint64_t estimate = top / v[m - 1];
+            uint64_t rest = top % v[m - 1];
+            while (estimate >= limb_base || estimate * v[m - 2] > rest * limb_base + u[j + m - 2]) {
+                estimate--;
+                rest += v[m - 1];
+                if (rest >= limb_base) {
+                    break;
+                }
+            }
 
-  private:
-    int char_to_digit_radix(char c) {
+            // u[j, j + m] -= estimate * v, adding v back once if that goes below zero.
+            uint64_t carry = 0;
+            int64_t borrow = 0;
+            for (size_t i = 0; i < m; i++) {
+                uint64_t product = estimate * v[i] + carry;
+                carry = product / limb_base;
+                int64_t diff = (int64_t)u[i + j] - (int64_t)(product % limb_base) - borrow;
+                borrow = diff < 0;
+                u[i + j] = (Limb)(diff + (borrow ? limb_base : 0));
+            }
+            int64_t top_diff = (int64_t)u[j + m] - (int64_t)carry - borrow;
+            if (top_diff < 0) {
+                estimate--;
+                Limb add_carry = 0;
+                for (size_t i = 0; i < m; i++) {
+                    Limb sum = u[i + j] + v[i] + add_carry;
+                    add_carry = sum >= limb_base;
+                    u[i + j] = add_carry ? sum - limb_base : sum;
+                }
+                top_diff += add_carry;
+            }
+            u[j + m] = (Limb)top_diff;
+            quotient[j] = (Limb)estimate;
+        }
+        trim(quotient);
+        return quotient;
+    }
+
+    static int char_to_digit_radix(char c) {
         if (c < '0')
             return -1;
 
@@ -422,12 +667,13 @@ template <typename Digit = Digit<>> class DynNum {
         char c = '\0';
         int radix = Digit::radix;
 
+        std::string digits;
         int integer_digits = parse_digits_lexeme(p, digits);
         if (integer_digits == 0 && *p != '.') {
             return false;
         }
 
-        dot_index = integer_digits;
+        int dot_index = integer_digits;
 
         p += integer_digits;
         c = *p;
@@ -451,38 +697,37 @@ template <typename Digit = Digit<>> class DynNum {
                 p++;
             }
 
-            std::deque<Digit> exponent_digits;
+            std::string exponent_digits;
 
             if (parse_digits_lexeme(p, exponent_digits) == 0) {
                 return false;
             }
 
             for (int i = exponent_digits.size() - 1; i >= 0; i--) {
-                dot_index += exponent_digit * exponent_digits[i].value;
+                dot_index += exponent_digit * char_to_digit_radix(exponent_digits[i]);
                 exponent_digit *= radix;
             }
         }
 
+        exponent = dot_index - (int)digits.size();
+        limbs = pack(digits);
         normalize();
 
         return true;
     }
 
-    int parse_digits_lexeme(const char* p, std::deque<Digit>& digits) {
+    int parse_digits_lexeme(const char* p, std::string& digits) {
         int digit_count = 0;
-        unsigned char digit = '\0';
 
-        while (true) {
-            digit = char_to_digit_radix(*p);
-            if (digit == (unsigned char)-1)
-                break;
+        while (char_to_digit_radix(*p) >= 0) {
+            digits.push_back(*p);
             p++;
-            digits.push_back(Digit(digit));
             digit_count++;
         }
 
         return digit_count;
     }
-};
 
-template <typename T> DynNum<T> DynNum<T>::one = DynNum(false, 1, {Digit(1)});
+    int exponent = 0;
+    Limbs limbs{};
+};
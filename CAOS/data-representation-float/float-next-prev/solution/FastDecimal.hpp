@@ -0,0 +1,443 @@
+#pragma once
+
+#include "NativeFloat.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+
+// A decimal string as float_parse reads it: "-0.184656560E-25", "174023074E26", ".5" or "1.",
+// and inf, infinity or nan in any case, each with an optional sign. Anything else is NaN.
+struct DecimalString {
+    enum class Kind { Number, Inf, NaN };
+
+    // At most this many leading significant digits go into leading, as many as a uint64_t holds.
+    static constexpr int leading_digits = 19;
+
+    Kind kind = Kind::NaN;
+    bool sign = false;
+
+    // A number is worth its digit_count significant digits times 10^exponent. They are the
+    // digits of mantissa from the first nonzero one on, the dot skipped.
+    std::string_view mantissa;
+    long long digit_count = 0;
+    long long exponent = 0;
+
+    // The first leading_digits of them, and whether any of the rest is nonzero.
+    uint64_t leading = 0;
+    bool truncated = false;
+
+    static DecimalString scan(std::string_view string) {
+        DecimalString result;
+        size_t i = 0;
+        if (i < string.size() && (string[i] == '+' || string[i] == '-')) {
+            result.sign = string[i++] == '-';
+        }
+        std::string_view rest = string.substr(i);
+        if (equal_ignore_case(rest, "inf") || equal_ignore_case(rest, "infinity")) {
+            result.kind = Kind::Inf;
+            return result;
+        }
+
+        size_t start = i;
+        bool seen_digit = false;
+        bool seen_dot = false;
+        long long exponent = 0;
+        for (; i < string.size(); ++i) {
+            char c = string[i];
+            if (c == '.' && !seen_dot) {
+                seen_dot = true;
+                continue;
+            }
+            if (c < '0' || c > '9') {
+                break;
+            }
+            seen_digit = true;
+
+            if (result.digit_count == 0 && c == '0') {
+                start = i + 1;
+                exponent -= seen_dot;
+                continue;
+            }
+            if (result.digit_count < leading_digits) {
+                result.leading = result.leading * 10 + (uint64_t)(c - '0');
+            } else {
+                result.truncated |= c != '0';
+            }
+            result.digit_count++;
+            exponent -= seen_dot;
+        }
+        if (!seen_digit) {
+            return result;
+        }
+        result.mantissa = string.substr(start, i - start);
+
+        if (i < string.size() && (string[i] == 'e' || string[i] == 'E')) {
+            ++i;
+            bool exponent_sign = false;
+            if (i < string.size() && (string[i] == '+' || string[i] == '-')) {
+                exponent_sign = string[i++] == '-';
+            }
+            if (i == string.size()) {
+                return result;
+            }
+            // Saturates far past any exponent that still changes the result.
+            long long written = 0;
+            for (; i < string.size() && string[i] >= '0' && string[i] <= '9'; ++i) {
+                written = std::min<long long>(written * 10 + (string[i] - '0'), 1ll << 40);
+            }
+            exponent += exponent_sign ? -written : written;
+        }
+        if (i != string.size()) {
+            return result;
+        }
+
+        result.kind = Kind::Number;
+        result.exponent = exponent;
+        return result;
+    }
+
+  private:
+    static constexpr bool equal_ignore_case(std::string_view string, std::string_view lower) {
+        if (string.size() != lower.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < string.size(); ++i) {
+            char c = string[i] >= 'A' && string[i] <= 'Z' ? (char)(string[i] - 'A' + 'a') : string[i];
+            if (c != lower[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Decimal conversions of the formats NativeFloat64 holds, on 128-bit approximations of the
+// powers of five instead of big integers. parse is the Eisel-Lemire algorithm: the leading
+// digits times 5^q, of which 128 bits decide the rounding unless the product lies within a unit
+// of a halfway point. shortest follows Ryu: the value and the halfway points to its neighbours
+// are scaled by 10^-k to about 100 bits, where the shortest decimal between them is found. Both
+// give up, returning false, on the few inputs the approximation leaves undecided, and the
+// caller then takes the exact path over DynNum and BigInt.
+struct FastDecimal {
+    static constexpr int min_power = -400;
+    static constexpr int max_power = 400;
+
+    static constexpr bool fits(int exponent_bits, int mantissa_bits) {
+        return NativeFloat64::fits(exponent_bits, mantissa_bits) && mantissa_bits <= 60;
+    }
+
+    // number as decimal digits rounded into the format, to nearest with ties to even.
+    static bool parse(const DecimalString& number, int exponent_bits, int mantissa_bits, NativeFloat64& result) {
+        if (number.digit_count == 0) {
+            result = {number.sign, 0, 0};
+            return true;
+        }
+        long long power = number.exponent + std::max<long long>(number.digit_count - DecimalString::leading_digits, 0);
+        if (!round_decimal(number.sign, number.leading, power, exponent_bits, mantissa_bits, result)) {
+            return false;
+        }
+        if (!number.truncated) {
+            return true;
+        }
+        // The digits lie strictly between leading and leading + 1, so rounding is settled when
+        // both ends round to the same value.
+        NativeFloat64 above;
+        if (!round_decimal(number.sign, number.leading + 1, power, exponent_bits, mantissa_bits, above)) {
+            return false;
+        }
+        return above.exponent == result.exponent && above.mantissa == result.mantissa;
+    }
+
+    // The fewest significant digits that parse back to value, the closest of them to it with
+    // ties to an even last digit. Leaves them in digits as characters, at most 40 of them, worth
+    // 0.d1d2... * 10^dot_index, and returns their count. value must be finite and nonzero.
+    static bool shortest(const NativeFloat64& value, int exponent_bits, int mantissa_bits, char* digits, int& count,
+                         int& dot_index) {
+        uint64_t mantissa = value.real_mantissa(mantissa_bits);
+        long long exponent = value.real_exponent() - NativeFloat64::bias(exponent_bits) - mantissa_bits - 2;
+        // value and its halfway points in units of 2^exponent. The one below is nearer when the
+        // value is the first of a binade past the denormals, and past the largest finite value
+        // parse overflows, so that one is its own bound above.
+        bool largest = value.exponent == NativeFloat64::max_exponent(exponent_bits) - 1 &&
+                       value.mantissa == ((uint64_t)1 << mantissa_bits) - 1;
+        uint64_t halfway_above = largest ? 4 * mantissa : 4 * mantissa + 2;
+        uint64_t halfway_below = value.mantissa == 0 && value.exponent > 1 ? 4 * mantissa - 1 : 4 * mantissa - 2;
+        bool inclusive_below = mantissa % 2 == 0;
+        bool inclusive_above = inclusive_below || largest;
+
+        long long magnitude = exponent + 64 - std::countl_zero(halfway_above) - (mantissa_bits + guard_bits);
+        if (magnitude < -1600 || magnitude > 1600) {
+            return false;
+        }
+        // floor(magnitude * log10(2)).
+        long long k = (magnitude * 78913) >> 18;
+        long long power = -k;
+        if (power < min_power || power > max_power) {
+            return false;
+        }
+        const Power& scale = table().powers[power - min_power];
+        int shift = (int)-(scale.exponent + exponent + power);
+
+        Scaled scaled = multiply(4 * mantissa, scale, shift);
+        Scaled above = multiply(halfway_above, scale, shift);
+        Scaled below = multiply(halfway_below, scale, shift);
+
+        // The widest power of ten with a multiple between the halfway points, then the
+        // multiples there. Their distance is at least 2^(guard_bits - 3).
+        uint128_t width = above.value - below.value;
+        int j = 0;
+        while (j + 1 < max_digits && pow10(j + 1) <= width) {
+            ++j;
+        }
+        uint128_t first = 0, last = 0;
+        int found = multiples(below, above, inclusive_below, inclusive_above, j + 1, first, last);
+        if (found < 0) {
+            return false;
+        }
+        if (found > 0) {
+            ++j;
+            for (uint128_t wider_first = 0, wider_last = 0; j + 1 < max_digits; ++j) {
+                found = multiples(below, above, inclusive_below, inclusive_above, j + 1, wider_first, wider_last);
+                if (found < 0) {
+                    return false;
+                }
+                if (found == 0) {
+                    break;
+                }
+                first = wider_first;
+                last = wider_last;
+            }
+        } else {
+            for (; j >= 0; --j) {
+                found = multiples(below, above, inclusive_below, inclusive_above, j, first, last);
+                if (found < 0) {
+                    return false;
+                }
+                if (found > 0) {
+                    break;
+                }
+            }
+            if (j < 0) {
+                return false;
+            }
+        }
+
+        // The multiple nearest to the value, kept between the halfway points.
+        uint128_t unit = pow10(j);
+        uint128_t nearest = scaled.value / unit;
+        uint128_t remainder = scaled.value % unit;
+        uint128_t half = unit / 2;
+        if (j == 0 || (scaled.state == State::Approximate && remainder + 1 >= half && remainder <= half)) {
+            return false;
+        }
+        bool up = remainder > half || (remainder == half && (scaled.state == State::Sticky || nearest % 2 != 0));
+        nearest = std::clamp(nearest + up, first, last);
+
+        count = (uint64_t)(nearest >> 64) == 0 ? write_digits((uint64_t)nearest, digits) : write_digits(nearest, digits);
+        dot_index = (int)(count + j + k);
+        return true;
+    }
+
+  private:
+    // How far a product of 128 bits of 5^q is from the true one: equal, above it by less than
+    // one, or above it by less than two.
+    enum class State { Exact, Sticky, Approximate };
+
+    struct Scaled {
+        uint128_t value;
+        State state;
+    };
+
+    // 5^q, truncated to 128 bits with the highest one set, is significand * 2^exponent, which
+    // is exact for q from 0 to 55.
+    struct Power {
+        uint128_t significand;
+        int exponent;
+        bool exact;
+    };
+
+    struct Table {
+        Power powers[max_power - min_power + 1];
+
+        Table() {
+            using Wide = StaticLongInt<18, false, uint64_t>;
+            Wide power = 1;
+            for (int q = 0; q <= max_power; ++q) {
+                int length = Wide::get_digit_count() * 64 - power.countl_zero();
+                Wide top = length > 128 ? power >> (length - 128) : power << (128 - length);
+                powers[q - min_power] = {NativeWide<uint128_t>::from_digits(top.get_digits(), 2), length - 128,
+                                         length <= 128};
+
+                // 2^(length + 127) / 5^q lies strictly between 2^127 and 2^128.
+                if (q > 0) {
+                    Wide dividend = 1;
+                    dividend <<= length + 127;
+                    Wide quotient = 0, remainder = 0;
+                    Wide::divmod(dividend, power, quotient, remainder);
+                    powers[-q - min_power] = {NativeWide<uint128_t>::from_digits(quotient.get_digits(), 2),
+                                              -(length + 127), false};
+                }
+                power *= Wide(5);
+            }
+        }
+    };
+
+    // shortest() scales the value to this many bits past its mantissa, so that the halfway
+    // points lie far more than the two units a product may be off apart, and divisions by the
+    // powers of ten between them take 64-bit divisors.
+    static constexpr int guard_bits = 40;
+    static constexpr int max_digits = 39;
+
+    static const Table& table() {
+        static const Table instance;
+        return instance;
+    }
+
+    static uint128_t pow10(int power) {
+        static constexpr auto powers = [] {
+            std::array<uint128_t, max_digits> powers{};
+            uint128_t power = 1;
+            for (uint128_t& entry : powers) {
+                entry = power;
+                power *= 10;
+            }
+            return powers;
+        }();
+        return powers[power];
+    }
+
+    template <typename Integer> static int write_digits(Integer value, char* digits) {
+        int count = 0;
+        for (; value != 0; value /= 10) {
+            digits[count++] = (char)('0' + (int)(value % 10));
+        }
+        std::reverse(digits, digits + count);
+        return count;
+    }
+
+    // (x * 5^q) >> shift from the table, where it fits 128 bits.
+    static Scaled multiply(uint64_t x, const Power& scale, int shift) {
+        uint128_t low = (uint128_t)x * (uint64_t)scale.significand;
+        uint128_t high = (uint128_t)x * (uint64_t)(scale.significand >> 64) + (low >> 64);
+        uint64_t bottom = (uint64_t)low;
+
+        uint128_t value;
+        bool inexact;
+        if (shift >= 64) {
+            value = high >> (shift - 64);
+            inexact = bottom != 0 || (high & (((uint128_t)1 << (shift - 64)) - 1)) != 0;
+        } else {
+            value = (high << (64 - shift)) | (bottom >> shift);
+            inexact = (bottom & (((uint64_t)1 << shift) - 1)) != 0;
+        }
+
+        if (!scale.exact) {
+            return {value, State::Approximate};
+        }
+        return {value, inexact ? State::Sticky : State::Exact};
+    }
+
+    // Where n lies against the true value of bound: -1 below, 0 on it, 1 above, or 2 when the
+    // product does not tell.
+    static int compare(uint128_t n, const Scaled& bound) {
+        switch (bound.state) {
+        case State::Exact:
+            return n < bound.value ? -1 : n > bound.value;
+        case State::Sticky:
+            return n <= bound.value ? -1 : 1;
+        default:
+            return n < bound.value ? -1 : n >= bound.value + 2 ? 1 : 2;
+        }
+    }
+
+    // Finds the multiples first * 10^j to last * 10^j that lie between below and above, and
+    // returns 1, or 0 if there are none, or -1 if the products leave it open.
+    static int multiples(const Scaled& below, const Scaled& above, bool inclusive_below, bool inclusive_above, int j,
+                         uint128_t& first, uint128_t& last) {
+        uint128_t unit = pow10(j);
+        auto inside = [&](uint128_t multiple) {
+            int low = compare(multiple * unit, below);
+            int high = compare(multiple * unit, above);
+            if (low == 2 || high == 2) {
+                return -1;
+            }
+            return (low > 0 || (low == 0 && inclusive_below)) && (high < 0 || (high == 0 && inclusive_above)) ? 1 : 0;
+        };
+
+        // The true bounds lie less than two units past the products, so a few steps from the
+        // multiples at or below them settle both ends.
+        for (first = below.value / unit;; ++first) {
+            if (first * unit > above.value + 1) {
+                return 0;
+            }
+            int state = inside(first);
+            if (state != 0) {
+                if (state < 0) {
+                    return state;
+                }
+                break;
+            }
+        }
+        for (last = above.value / unit + 1;; --last) {
+            int state = inside(last);
+            if (state != 0) {
+                if (state < 0) {
+                    return state;
+                }
+                return 1;
+            }
+        }
+    }
+
+    // w * 10^q rounded into the format, or false when the approximation of 5^q leaves it undecided.
+    static bool round_decimal(bool sign, uint64_t w, long long q, int exponent_bits, int mantissa_bits,
+                              NativeFloat64& result) {
+        if (q < min_power || q > max_power) {
+            return false;
+        }
+        const Power& scale = table().powers[q - min_power];
+        int lz = std::countl_zero(w);
+        Scaled x = multiply(w << lz, scale, 66);
+        // value = x * 2^(exponent - bias - mantissa_bits), as NativeFloat::round takes it.
+        long long exponent = 66 + scale.exponent + q - lz + NativeFloat64::bias(exponent_bits) + mantissa_bits;
+
+        // The bits round() drops, found as it does.
+        uint128_t value = x.value;
+        long long pos = NativeWide<uint128_t>::bit_length(value) - mantissa_bits - 1;
+        if (exponent + pos <= 0) {
+            pos += 1 - (exponent + pos);
+        }
+        if (x.state == State::Approximate && pos <= 128) {
+            uint128_t mask = pos == 128 ? ~(uint128_t)0 : ((uint128_t)1 << pos) - 1;
+            uint128_t half = (uint128_t)1 << (pos - 1);
+            uint128_t dropped = value & mask;
+            if (dropped == half || dropped + 1 == half) {
+                return false;
+            }
+        }
+
+        NativeFloat64 rounded = NativeFloat64::round(
+            sign, x.state == State::Sticky ? exponent - 1 : exponent,
+            // The true product of a sticky one is a little more than x, below the next unit.
+            x.state == State::Sticky ? (value << 1) | 1 : value, exponent_bits, mantissa_bits);
+
+        // Anything past the largest finite value is inf, also what would round down to it.
+        long long top = NativeFloat64::max_exponent(exponent_bits) - 1;
+        uint64_t all_ones = ((uint64_t)1 << mantissa_bits) - 1;
+        if (rounded.exponent == top && rounded.mantissa == all_ones) {
+            uint128_t largest = (uint128_t)(all_ones | ((uint64_t)1 << mantissa_bits)) << pos;
+            bool past = x.state == State::Exact ? value > largest : value >= largest;
+            if (x.state == State::Approximate && value + 1 >= largest && value <= largest) {
+                return false;
+            }
+            if (past) {
+                rounded = NativeFloat64::inf(sign, exponent_bits);
+            }
+        }
+        result = rounded;
+        return true;
+    }
+};
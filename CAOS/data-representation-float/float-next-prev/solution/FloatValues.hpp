@@ -0,0 +1,123 @@
+#pragma once
+
+#include "floats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+// Every value of a format of up to 32 bits, in the order of the encodings float_get_bits gives:
+// +0 up through the denormals and normals to +inf and the NaNs, then -0 down to -inf and the
+// negative NaNs. Stepping writes the next encoding straight into the fields with float_set_bits,
+// so a sweep costs no float_next and no BigInt arithmetic per value.
+//
+//     for (const Float& value : FloatValues(5, 10)) { ... }
+//
+// The Float the iterator gives is its own and changes on every step; copy it to keep it.
+class FloatValues {
+  public:
+    class iterator {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Float;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Float*;
+        using reference = const Float&;
+
+        iterator() = default;
+
+        iterator(int exponent_bits, int mantissa_bits, uint64_t bits) : bits(bits) {
+            [[maybe_unused]] int error = float_init(&value, exponent_bits, mantissa_bits);
+            assert(error == 0);
+            float_set_bits(&value, bits);
+        }
+
+        const Float& operator*() const { return value; }
+        const Float* operator->() const { return &value; }
+
+        uint64_t encoding() const { return bits; }
+
+        iterator& operator++() {
+            float_set_bits(&value, ++bits);
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        // Only the position counts, so any iterator compares equal to the one end() gives.
+        bool operator==(const iterator& other) const { return bits == other.bits; }
+
+      private:
+        friend class FloatValues;
+
+        explicit iterator(uint64_t bits) : bits(bits) {}
+
+        uint64_t bits = 0;
+        Float value;
+    };
+
+    static constexpr bool fits(int exponent_bits, int mantissa_bits) {
+        return exponent_bits >= 2 && mantissa_bits >= 1 && exponent_bits + mantissa_bits + 1 <= 32;
+    }
+
+    FloatValues(int exponent_bits, int mantissa_bits)
+        : FloatValues(exponent_bits, mantissa_bits, 0, (uint64_t)1 << (exponent_bits + mantissa_bits + 1)) {}
+
+    // The values whose encodings lie in [first, last).
+    FloatValues(int exponent_bits, int mantissa_bits, uint64_t first, uint64_t last)
+        : exponent_bits(exponent_bits), mantissa_bits(mantissa_bits), first(first), last(last) {
+        assert(fits(exponent_bits, mantissa_bits));
+        assert(first <= last && last <= (uint64_t)1 << (exponent_bits + mantissa_bits + 1));
+    }
+
+    iterator begin() const { return iterator(exponent_bits, mantissa_bits, first); }
+    iterator end() const { return iterator(last); }
+
+    uint64_t size() const { return last - first; }
+
+    // Calls body(value) for every value, on threads threads that take chunks of chunk_size
+    // encodings in turn. Each thread steps its own Float, so body runs concurrently and has to
+    // synchronize whatever it shares. The order of the calls is unspecified.
+    template <typename Body>
+    void sweep(Body body, unsigned threads = std::thread::hardware_concurrency(), uint64_t chunk_size = 1 << 14) const {
+        uint64_t chunks = (size() + chunk_size - 1) / chunk_size;
+        threads = (unsigned)std::min<uint64_t>(std::max(threads, 1u), chunks);
+        if (threads <= 1) {
+            for (const Float& value : *this) {
+                body(value);
+            }
+            return;
+        }
+
+        std::atomic<uint64_t> next_chunk = 0;
+        auto work = [&]() {
+            for (uint64_t chunk = next_chunk++; chunk < chunks; chunk = next_chunk++) {
+                uint64_t start = first + chunk * chunk_size;
+                for (const Float& value : FloatValues(exponent_bits, mantissa_bits, start,
+                                                      std::min(last, start + chunk_size))) {
+                    body(value);
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < threads; ++i) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+  private:
+    int exponent_bits;
+    int mantissa_bits;
+    uint64_t first;
+    uint64_t last;
+};
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <type_traits>
 #include <vector>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <climits>
@@ -99,7 +100,7 @@ template <typename Storage> class LongInt {
         return with_digits(other.storage.get_digit_count());
     }
 
-    static LongInt as(const LongInt& other)
+    static constexpr LongInt as(const LongInt& other)
         requires(Storage::is_static)
     {
         return LongInt();
@@ -182,17 +183,18 @@ template <typename Storage> class LongInt {
     constexpr LongInt& operator*=(const LongInt& other) {
         LongInt a = is_negative() ? -*this : *this;
         LongInt b = other.is_negative() ? -other : other;
-        LongInt result = LongInt::as(*this);
-        LongInt tmp = LongInt::as(*this);
+        int a_size = a.significant_digits();
+        int b_size = b.significant_digits();
 
-        typedef typename LargerType<Digit>::type LargeType;
-        for (int i = 0; i < get_digit_count(); ++i) {
-            for (int j = 0; j < get_digit_count(); ++j) {
-                tmp = (LargeType)a.get_digits()[i] * (LargeType)b.get_digits()[j];
-                tmp <<= (i + j) * get_digit_bitlength();
-                result += tmp;
-            }
+        // Only the significant digits are multiplied, then the product is cut to the width.
+        LongInt result = LongInt::as(*this);
+        if (a_size != 0 && b_size != 0) {
+            with_scratch(a_size + b_size, [&](Digit* product) {
+                mul_digits(a.get_digits(), a_size, b.get_digits(), b_size, product);
+                std::copy(product, product + std::min(a_size + b_size, get_digit_count()), result.get_digits());
+            });
         }
+
         if (get_signed() && is_negative() != other.is_negative()) {
             result = -result;
         }
@@ -200,6 +202,86 @@ template <typename Storage> class LongInt {
         return *this;
     }
 
+    constexpr LongInt operator/(const LongInt& other) const {
+        auto quotient = LongInt::as(*this);
+        auto remainder = LongInt::as(*this);
+        divmod(*this, other, quotient, remainder);
+        return quotient;
+    }
+
+    constexpr LongInt& operator/=(const LongInt& other) {
+        *this = *this / other;
+        return *this;
+    }
+
+    constexpr LongInt operator%(const LongInt& other) const {
+        auto quotient = LongInt::as(*this);
+        auto remainder = LongInt::as(*this);
+        divmod(*this, other, quotient, remainder);
+        return remainder;
+    }
+
+    constexpr LongInt& operator%=(const LongInt& other) {
+        *this = *this % other;
+        return *this;
+    }
+
+    // result = a * b for non-negative a and b whose significant digits fit result together; result
+    // must be neither. Allocates nothing unless the operands are long enough for Karatsuba.
+    static constexpr void mul_to(const LongInt& a, const LongInt& b, LongInt& result) {
+        int a_size = a.significant_digits();
+        int b_size = b.significant_digits();
+        assert(a_size + b_size <= result.get_digit_count());
+
+        result = 0;
+        if (a_size != 0 && b_size != 0) {
+            mul_digits(a.get_digits(), a_size, b.get_digits(), b_size, result.get_digits());
+        }
+    }
+
+    // divmod for non-negative a and b with the scratch passed in: work holds the significant
+    // digits of both plus one. quotient and remainder must be neither a nor b.
+    static constexpr void divmod_to(const LongInt& a, const LongInt& b, LongInt& quotient, LongInt& remainder,
+                                    Digit* work) {
+        assert(!b.is_zero());
+        int a_size = a.significant_digits();
+        int b_size = b.significant_digits();
+
+        quotient = 0;
+        remainder = 0;
+        if (a_size < b_size || (a_size == b_size && less_digits(a.get_digits(), b.get_digits(), a_size))) {
+            remainder = a;
+        } else if (b_size == 1) {
+            remainder.get_digits()[0] =
+                div_digit(a.get_digits(), a_size, b.get_digits()[0], quotient.get_digits());
+        } else {
+            div_digits(a.get_digits(), a_size, b.get_digits(), b_size, quotient.get_digits(),
+                       remainder.get_digits(), work);
+        }
+    }
+
+    // Truncating division, as for built-in integers: the quotient is rounded towards zero and the
+    // remainder takes the sign of the dividend. All four must have the same digit count.
+    static constexpr void divmod(const LongInt& dividend, const LongInt& divisor, LongInt& quotient,
+                                 LongInt& remainder) {
+        assert(!divisor.is_zero());
+        bool dividend_negative = dividend.is_negative();
+        bool divisor_negative = divisor.is_negative();
+        LongInt a = dividend_negative ? -dividend : dividend;
+        LongInt b = divisor_negative ? -divisor : divisor;
+        int a_size = a.significant_digits();
+        int b_size = b.significant_digits();
+
+        with_scratch(a_size + b_size + 1, [&](Digit* work) { divmod_to(a, b, quotient, remainder, work); });
+
+        if (get_signed() && dividend_negative != divisor_negative) {
+            quotient = -quotient;
+        }
+        if (get_signed() && dividend_negative) {
+            remainder = -remainder;
+        }
+    }
+
     constexpr LongInt& operator<<=(int shift) {
         assert(shift >= 0);
         if (shift == 0) {
@@ -253,7 +335,7 @@ template <typename Storage> class LongInt {
                 get_digits()[i] = low >> shift_bits;
             }
 
-            if (i < get_digit_count() - shift_digits - 1) {
+            if (shift_bits != 0 && i < get_digit_count() - shift_digits - 1) {
                 Digit high = get_digits()[i + shift_digits + 1];
                 get_digits()[i] |= high << (get_digit_bitlength() - shift_bits);
             }
@@ -326,24 +408,26 @@ template <typename Storage> class LongInt {
     }
 
     constexpr LongInt& operator++() {
-        *this += (as(*this) = 1);
+        const Digit one = 1;
+        add_digits(get_digits(), get_digit_count(), &one, 1);
         return *this;
     }
 
     constexpr LongInt& operator--() {
-        *this -= (as(*this) = 1);
+        const Digit one = 1;
+        sub_digits(get_digits(), get_digit_count(), &one, 1);
         return *this;
     }
 
     constexpr LongInt operator++(int) {
         auto result = *this;
-        *this += (as(*this) = 1);
+        ++*this;
         return result;
     }
 
     constexpr LongInt operator--(int) {
         auto result = *this;
-        *this -= (as(*this) = 1);
+        --*this;
         return result;
     }
 
@@ -392,6 +476,16 @@ template <typename Storage> class LongInt {
         return get_digit_bitlength() * get_digit_count();
     }
 
+    constexpr int countr_zero() const {
+        for (int i = 0; i < get_digit_count(); i++) {
+            int zero = std::countr_zero(get_digits()[i]);
+            if (zero < get_digit_bitlength()) {
+                return i * get_digit_bitlength() + zero;
+            }
+        }
+        return get_digit_bitlength() * get_digit_count();
+    }
+
     constexpr bool is_zero() const {
         for (int i = 0; i < get_digit_count(); i++) {
             if (get_digits()[i] != 0)
@@ -402,8 +496,9 @@ template <typename Storage> class LongInt {
 
     constexpr explicit operator unsigned long long() const {
         unsigned long long result = 0;
-        memcpy((void*)&result, (void*)get_digits(),
-               std::min(sizeof(result), (size_t)get_digit_count() * get_digit_bitlength() / CHAR_BIT));
+        for (int i = 0; i < get_digit_count() && i * get_digit_bitlength() < sizeof(result) * CHAR_BIT; i++) {
+            result |= (unsigned long long)get_digits()[i] << i * get_digit_bitlength();
+        }
         if (is_negative()) {
             for (int i = get_digit_count() * get_digit_bitlength() / CHAR_BIT; i < sizeof(unsigned long long); i++) {
                 result |= ((unsigned long long)(Digit)-1) << i * 8;
@@ -422,9 +517,209 @@ template <typename Storage> class LongInt {
     Storage storage;
 
   private:
+    using LargeType = typename LargerType<Digit>::type;
+
+    // Below this many digits in the shorter operand Karatsuba costs more than it saves.
+    static constexpr int karatsuba_threshold = 24;
+
     constexpr LongInt(int digits, std::false_type nothing)
         requires(!Storage::is_static)
         : storage(digits) {}
+
+    // Calls function with size zeroed digits of scratch: on the stack for static storage, where
+    // size never exceeds twice the digit count plus one.
+    template <typename Function> static constexpr void with_scratch(int size, Function function) {
+        if constexpr (Storage::is_static) {
+            Digit scratch[2 * Storage::get_digit_count() + 1]{};
+            function(scratch);
+        } else {
+            std::vector<Digit> scratch(size);
+            function(scratch.data());
+        }
+    }
+
+    constexpr int significant_digits() const {
+        int size = get_digit_count();
+        while (size > 0 && get_digits()[size - 1] == 0) {
+            size--;
+        }
+        return size;
+    }
+
+    // Unsigned comparison of two n-digit numbers; magnitudes may have the sign bit set.
+    static constexpr bool less_digits(const Digit* a, const Digit* b, int n) {
+        for (int i = n - 1; i >= 0; --i) {
+            if (a[i] != b[i]) {
+                return a[i] < b[i];
+            }
+        }
+        return false;
+    }
+
+    // a[0, n) += b[0, m) for m <= n, returns the carry out of a[n - 1].
+    static constexpr Digit add_digits(Digit* a, int n, const Digit* b, int m) {
+        Digit carry = 0;
+        for (int i = 0; i < n && (i < m || carry); ++i) {
+            Digit addend = i < m ? b[i] : 0;
+            Digit sum = a[i] + addend + carry;
+            carry = sum < a[i] || (carry && sum == a[i]);
+            a[i] = sum;
+        }
+        return carry;
+    }
+
+    // a[0, n) -= b[0, m) for m <= n, returns the borrow out of a[n - 1].
+    static constexpr Digit sub_digits(Digit* a, int n, const Digit* b, int m) {
+        Digit borrow = 0;
+        for (int i = 0; i < n && (i < m || borrow); ++i) {
+            Digit subtrahend = i < m ? b[i] : 0;
+            Digit diff = a[i] - subtrahend - borrow;
+            borrow = subtrahend > a[i] || (subtrahend == a[i] && borrow);
+            a[i] = diff;
+        }
+        return borrow;
+    }
+
+    // out[0, n + m) = a[0, n) * b[0, m). The double-width products are LargeType, which is
+    // unsigned __int128 for 64-bit digits and compiles to a single mul (mulx with BMI2).
+    static constexpr void mul_digits(const Digit* a, int n, const Digit* b, int m, Digit* out) {
+        if (n < m) {
+            std::swap(a, b);
+            std::swap(n, m);
+        }
+
+        if (m < karatsuba_threshold) {
+            std::fill(out, out + n + m, Digit(0));
+            for (int i = 0; i < m; ++i) {
+                Digit carry = 0;
+                for (int j = 0; j < n; ++j) {
+                    LargeType cur = (LargeType)a[j] * b[i] + out[i + j] + carry;
+                    out[i + j] = (Digit)cur;
+                    carry = (Digit)(cur >> get_digit_bitlength());
+                }
+                out[i + n] = carry;
+            }
+            return;
+        }
+
+        // Far from balanced: a is cut into pieces of m digits, each a balanced product.
+        if (2 * m <= n) {
+            std::fill(out, out + n + m, Digit(0));
+            std::vector<Digit> part(2 * m);
+            for (int i = 0; i < n; i += m) {
+                int size = std::min(m, n - i);
+                mul_digits(a + i, size, b, m, part.data());
+                add_digits(out + i, n + m - i, part.data(), size + m);
+            }
+            return;
+        }
+
+        // a = a1 * B^half + a0, b = b1 * B^half + b0 and
+        // a * b = z2 * B^(2 half) + ((a0 + a1) * (b0 + b1) - z2 - z0) * B^half + z0.
+        int half = (n + 1) / 2;
+        int a_high = n - half;
+        int b_high = m - half;
+
+        std::fill(out, out + n + m, Digit(0));
+        mul_digits(a, half, b, half, out);
+        if (b_high > 0) {
+            mul_digits(a + half, a_high, b + half, b_high, out + 2 * half);
+        }
+
+        std::vector<Digit> sums(2 * (half + 1));
+        Digit* a_sum = sums.data();
+        Digit* b_sum = a_sum + half + 1;
+        std::copy(a, a + half, a_sum);
+        a_sum[half] = add_digits(a_sum, half, a + half, a_high);
+        std::copy(b, b + half, b_sum);
+        b_sum[half] = add_digits(b_sum, half, b + half, b_high);
+
+        std::vector<Digit> middle(2 * (half + 1));
+        mul_digits(a_sum, half + 1, b_sum, half + 1, middle.data());
+        sub_digits(middle.data(), (int)middle.size(), out, 2 * half);
+        sub_digits(middle.data(), (int)middle.size(), out + 2 * half, a_high + b_high);
+
+        int middle_size = std::min((int)middle.size(), n + m - half);
+        add_digits(out + half, n + m - half, middle.data(), middle_size);
+    }
+
+    // quotient[0, n) = a[0, n) / b, returns the remainder.
+    static constexpr Digit div_digit(const Digit* a, int n, Digit b, Digit* quotient) {
+        LargeType rest = 0;
+        for (int i = n - 1; i >= 0; --i) {
+            LargeType cur = (rest << get_digit_bitlength()) | a[i];
+            quotient[i] = (Digit)(cur / b);
+            rest = cur % b;
+        }
+        return (Digit)rest;
+    }
+
+    // Knuth's algorithm D for m >= 2 and n >= m: quotient[0, n - m + 1) and remainder[0, m).
+    static constexpr void div_digits(const Digit* a, int n, const Digit* b, int m, Digit* quotient,
+                                     Digit* remainder, Digit* work /* n + 1 + m */) {
+        const int bits = get_digit_bitlength();
+        const LargeType base = (LargeType)1 << bits;
+
+        // Both are shifted until the divisor's top digit has its top bit set, so that every
+        // estimated quotient digit is at most two too large.
+        int shift = std::countl_zero(b[m - 1]);
+        Digit* u = work;
+        Digit* v = work + n + 1;
+        for (int i = m - 1; i >= 0; --i) {
+            v[i] = (Digit)(b[i] << shift);
+            if (shift != 0 && i > 0) {
+                v[i] |= (Digit)(b[i - 1] >> (bits - shift));
+            }
+        }
+        u[n] = shift == 0 ? 0 : (Digit)(a[n - 1] >> (bits - shift));
+        for (int i = n - 1; i >= 0; --i) {
+            u[i] = (Digit)(a[i] << shift);
+            if (shift != 0 && i > 0) {
+                u[i] |= (Digit)(a[i - 1] >> (bits - shift));
+            }
+        }
+
+        for (int j = n - m; j >= 0; --j) {
+            LargeType top = ((LargeType)u[j + m] << bits) | u[j + m - 1];
+            LargeType q = top / v[m - 1];
+            LargeType r = top % v[m - 1];
+            while (q >= base || q * v[m - 2] > ((r << bits) | u[j + m - 2])) {
+                q--;
+                r += v[m - 1];
+                if (r >= base) {
+                    break;
+                }
+            }
+
+            // u[j, j + m] -= q * v; one add-back fixes the rare estimate that is still one too large.
+            Digit carry = 0;
+            Digit borrow = 0;
+            for (int i = 0; i < m; ++i) {
+                LargeType product = q * v[i] + carry;
+                carry = (Digit)(product >> bits);
+                Digit low = (Digit)product;
+                Digit diff = u[i + j] - low - borrow;
+                borrow = low > u[i + j] || (low == u[i + j] && borrow);
+                u[i + j] = diff;
+            }
+            Digit diff = u[j + m] - carry - borrow;
+            borrow = carry > u[j + m] || (carry == u[j + m] && borrow);
+            u[j + m] = diff;
+
+            if (borrow) {
+                q--;
+                u[j + m] += add_digits(u + j, m, v, m);
+            }
+            quotient[j] = (Digit)q;
+        }
+
+        for (int i = 0; i < m; ++i) {
+            remainder[i] = (Digit)(u[i] >> shift);
+            if (shift != 0) {
+                remainder[i] |= (Digit)(u[i + 1] << (bits - shift));
+            }
+        }
+    }
 };
 
 template <int _digit_count, bool _signed = true, typename Digit = unsigned char>
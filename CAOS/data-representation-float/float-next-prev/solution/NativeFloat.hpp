@@ -0,0 +1,377 @@
+#pragma once
+
+#include "LongInt.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+// Double-width intermediates of the fast paths: exact products and shifted dividends of two
+// Word mantissas. unsigned __int128 for 64-bit words, static 64-bit digits for wider ones.
+template <typename Wide> struct NativeWide {};
+
+template <> struct NativeWide<uint128_t> {
+    static constexpr int bits = 128;
+    static constexpr int word_bits = 64;
+
+    static constexpr uint128_t from(uint64_t word) { return word; }
+    static constexpr uint64_t to_word(uint128_t wide) { return (uint64_t)wide; }
+
+    static constexpr uint128_t from_digits(const uint64_t* digits, int count) {
+        uint128_t wide = 0;
+        for (int i = std::min(count, 2) - 1; i >= 0; --i) {
+            wide = (wide << 64) | digits[i];
+        }
+        return wide;
+    }
+    static constexpr bool is_zero(uint128_t wide) { return wide == 0; }
+
+    static constexpr int bit_length(uint128_t wide) {
+        uint64_t high = (uint64_t)(wide >> 64);
+        return high != 0 ? 128 - std::countl_zero(high) : 64 - std::countl_zero((uint64_t)wide);
+    }
+
+    static constexpr int countr_zero(uint128_t wide) {
+        uint64_t low = (uint64_t)wide;
+        return low != 0 ? std::countr_zero(low) : 64 + std::countr_zero((uint64_t)(wide >> 64));
+    }
+};
+
+// Words of 128 bits widen to four digits. Wider formats keep the mantissa in the Wide type
+// itself, of which only the lower half is used, so word_bits is half of the digits.
+template <int digit_count> struct NativeWide<StaticLongInt<digit_count, false, uint64_t>> {
+    using Wide = StaticLongInt<digit_count, false, uint64_t>;
+    static constexpr int bits = digit_count * 64;
+    static constexpr int word_bits = bits / 2;
+
+    static constexpr Wide from(uint128_t word) {
+        const uint64_t digits[] = {(uint64_t)word, (uint64_t)(word >> 64)};
+        return from_digits(digits, 2);
+    }
+    static constexpr const Wide& from(const Wide& word) { return word; }
+
+    static constexpr uint128_t to_word(const Wide& wide) {
+        return ((uint128_t)wide.get_digits()[1] << 64) | wide.get_digits()[0];
+    }
+
+    static constexpr Wide from_digits(const uint64_t* digits, int count) {
+        Wide wide = 0;
+        for (int i = 0; i < std::min(count, digit_count); ++i) {
+            wide.get_digits()[i] = digits[i];
+        }
+        return wide;
+    }
+
+    static constexpr bool is_zero(const Wide& wide) { return wide.is_zero(); }
+    static constexpr int bit_length(const Wide& wide) { return bits - wide.countl_zero(); }
+    static constexpr int countr_zero(const Wide& wide) { return wide.countr_zero(); }
+};
+
+using NativeWide256 = StaticLongInt<4, false, uint64_t>;
+
+// IEEE-style arithmetic on the stored fields of a format with at most Traits::word_bits bits
+// of exponent and mantissa together, and an exponent of at most 32 bits. Rounds to nearest,
+// ties to even, and follows floats.cpp for every special value.
+template <typename Word, typename Wide> struct NativeFloat {
+    using Traits = NativeWide<Wide>;
+
+    bool sign = false;
+    long long exponent = 0;
+    Word mantissa = 0;
+
+    static constexpr bool fits(int exponent_bits, int mantissa_bits) {
+        return exponent_bits <= 32 && exponent_bits + mantissa_bits <= Traits::word_bits;
+    }
+
+    // The mantissa as the 64-bit digits Float keeps it in, lowest first.
+    static constexpr Word word_from_digits(const uint64_t* digits, int count) {
+        if constexpr (std::is_same_v<Word, Wide>) {
+            return Traits::from_digits(digits, count);
+        } else {
+            return (Word)NativeWide<uint128_t>::from_digits(digits, count);
+        }
+    }
+
+    static constexpr void word_to_digits(const Word& word, uint64_t* digits, int count) {
+        for (int i = 0; i < count; ++i) {
+            if constexpr (std::is_same_v<Word, Wide>) {
+                digits[i] = i < word.get_digit_count() ? word.get_digits()[i] : 0;
+            } else {
+                digits[i] = i * 64 < (int)sizeof(Word) * CHAR_BIT ? (uint64_t)(word >> (i * 64)) : 0;
+            }
+        }
+    }
+
+    static constexpr long long max_exponent(int exponent_bits) { return (1ll << exponent_bits) - 1; }
+    static constexpr long long bias(int exponent_bits) { return (1ll << (exponent_bits - 1)) - 1; }
+
+    constexpr bool is_zero() const { return exponent == 0 && mantissa == 0; }
+    constexpr bool is_special(int exponent_bits) const { return exponent == max_exponent(exponent_bits); }
+    constexpr bool is_inf(int exponent_bits) const { return is_special(exponent_bits) && mantissa == 0; }
+    constexpr bool is_nan(int exponent_bits) const { return is_special(exponent_bits) && mantissa != 0; }
+
+    // Mantissa with the implicit bit and the exponent a denormal is scaled by.
+    constexpr Word real_mantissa(int mantissa_bits) const {
+        return exponent != 0 ? mantissa | (Word(1) << mantissa_bits) : mantissa;
+    }
+    constexpr long long real_exponent() const { return exponent != 0 ? exponent : 1; }
+
+    static constexpr NativeFloat nan(int exponent_bits, int mantissa_bits) {
+        return {false, max_exponent(exponent_bits), Word(1) << (mantissa_bits - 1)};
+    }
+    static constexpr NativeFloat inf(bool sign, int exponent_bits) { return {sign, max_exponent(exponent_bits), 0}; }
+
+    // mantissa * 2^(exponent - bias - mantissa_bits) rounded once into the format, as norm() does.
+    static constexpr NativeFloat round(bool sign, long long exponent, Wide mantissa, int exponent_bits,
+                                       int mantissa_bits) {
+        if (Traits::is_zero(mantissa)) {
+            return {sign, 0, 0};
+        }
+
+        long long pos = Traits::bit_length(mantissa) - mantissa_bits - 1;
+        exponent += pos;
+        bool denormal = exponent <= 0;
+        if (denormal) {
+            pos += 1 - exponent;
+            exponent = 0;
+        }
+
+        if (pos > 0) {
+            mantissa = round_shift(mantissa, pos);
+        } else {
+            mantissa = mantissa << (int)-pos;
+        }
+
+        Word result = to_word(mantissa);
+        Word implicit = Word(1) << mantissa_bits;
+        if (denormal) {
+            if (result == implicit) {
+                return {sign, 1, 0};
+            }
+            return {sign, 0, result};
+        }
+
+        if (result == implicit << 1) {
+            result >>= 1;
+            exponent++;
+        }
+        if (exponent >= max_exponent(exponent_bits)) {
+            return inf(sign, exponent_bits);
+        }
+        return {sign, exponent, result - implicit};
+    }
+
+    // a + b with b's sign taken as b_sign, aligned as add_signed() in floats.cpp does.
+    // round() for a mantissa of at most Traits::bits bits given as 64-bit digits, lowest first.
+    static constexpr NativeFloat round_digits(bool sign, long long exponent, const uint64_t* digits, int count,
+                                              int exponent_bits, int mantissa_bits) {
+        return round(sign, exponent, Traits::from_digits(digits, count), exponent_bits, mantissa_bits);
+    }
+
+    static constexpr NativeFloat add(const NativeFloat& a, const NativeFloat& b, bool b_sign, int exponent_bits,
+                                     int mantissa_bits) {
+        if (a.is_nan(exponent_bits)) {
+            return a;
+        }
+        if (b.is_nan(exponent_bits)) {
+            return b;
+        }
+        bool a_inf = a.is_inf(exponent_bits);
+        bool b_inf = b.is_inf(exponent_bits);
+        if (a_inf && b_inf && a.sign != b_sign) {
+            return nan(exponent_bits, mantissa_bits);
+        }
+        if (a_inf) {
+            return inf(a.sign, exponent_bits);
+        }
+        if (b_inf) {
+            return inf(b_sign, exponent_bits);
+        }
+        if (a.is_zero() && b.is_zero()) {
+            return {a.sign && b_sign, 0, 0};
+        }
+
+        Wide high = Traits::from(a.real_mantissa(mantissa_bits));
+        Wide low = Traits::from(b.real_mantissa(mantissa_bits));
+        long long high_exponent = a.real_exponent();
+        long long low_exponent = b.real_exponent();
+        bool high_sign = a.sign;
+        bool low_sign = b_sign;
+        if (high_exponent < low_exponent) {
+            std::swap(high, low);
+            std::swap(high_exponent, low_exponent);
+            std::swap(high_sign, low_sign);
+        }
+
+        long long difference = high_exponent - low_exponent;
+        long long shift = std::min<long long>(difference, mantissa_bits + 2);
+        high = high << (int)shift;
+        low = sticky_shift(low, difference - shift);
+
+        bool sign = high_sign;
+        Wide sum = Traits::from(0);
+        if (high_sign == low_sign) {
+            sum = high + low;
+        } else if (low < high) {
+            sum = high - low;
+        } else {
+            sum = low - high;
+            sign = Traits::is_zero(sum) ? false : low_sign;
+        }
+        return round(sign, high_exponent - shift, sum, exponent_bits, mantissa_bits);
+    }
+
+    static constexpr NativeFloat mul(const NativeFloat& a, const NativeFloat& b, int exponent_bits,
+                                     int mantissa_bits) {
+        if ((a.is_zero() && b.is_inf(exponent_bits)) || (b.is_zero() && a.is_inf(exponent_bits))) {
+            return nan(exponent_bits, mantissa_bits);
+        }
+        if (a.is_nan(exponent_bits)) {
+            return a;
+        }
+        if (b.is_nan(exponent_bits)) {
+            return b;
+        }
+        if (a.is_inf(exponent_bits) || b.is_inf(exponent_bits)) {
+            return inf(a.sign ^ b.sign, exponent_bits);
+        }
+
+        Wide product = Traits::from(a.real_mantissa(mantissa_bits)) * Traits::from(b.real_mantissa(mantissa_bits));
+        long long exponent = a.real_exponent() + b.real_exponent() - bias(exponent_bits) - mantissa_bits;
+        return round(a.sign ^ b.sign, exponent, product, exponent_bits, mantissa_bits);
+    }
+
+    static constexpr NativeFloat div(const NativeFloat& a, const NativeFloat& b, int exponent_bits,
+                                     int mantissa_bits) {
+        bool a_inf = a.is_inf(exponent_bits);
+        bool b_inf = b.is_inf(exponent_bits);
+        if ((a.is_zero() && b.is_zero()) || (a_inf && b_inf)) {
+            return nan(exponent_bits, mantissa_bits);
+        }
+        if (a.is_nan(exponent_bits)) {
+            return a;
+        }
+        if (b.is_nan(exponent_bits)) {
+            return b;
+        }
+        if (a_inf || b.is_zero()) {
+            return inf(a.sign ^ b.sign, exponent_bits);
+        }
+        if (b_inf || a.is_zero()) {
+            return {(bool)(a.sign ^ b.sign), 0, 0};
+        }
+
+        // As in float_div: the kept bits, a rounding bit and a sticky bit for a nonzero remainder.
+        Wide mant_a = Traits::from(a.real_mantissa(mantissa_bits));
+        Wide mant_b = Traits::from(b.real_mantissa(mantissa_bits));
+        int shift = mantissa_bits + 3 + Traits::bit_length(mant_b) - Traits::bit_length(mant_a);
+        mant_a = mant_a << shift;
+
+        Wide quotient = mant_a / mant_b;
+        if (!Traits::is_zero(mant_a - quotient * mant_b)) {
+            quotient = quotient | Traits::from(1);
+        }
+
+        long long exponent = a.real_exponent() - b.real_exponent() + bias(exponent_bits) + mantissa_bits - shift;
+        return round(a.sign ^ b.sign, exponent, quotient, exponent_bits, mantissa_bits);
+    }
+
+    // The fields of a finite or infinite value read as one integer step by one ulp, and
+    // the zeros step across the sign.
+    constexpr void next(int exponent_bits, int mantissa_bits) {
+        if (is_nan(exponent_bits)) {
+            return;
+        }
+        Word magnitude = ((Word)exponent << mantissa_bits) | mantissa;
+        if (sign) {
+            if (magnitude == 0) {
+                sign = false;
+                return;
+            }
+            magnitude--;
+        } else if (!is_inf(exponent_bits)) {
+            magnitude++;
+        }
+        set_magnitude(magnitude, mantissa_bits);
+    }
+
+    constexpr void prev(int exponent_bits, int mantissa_bits) {
+        if (is_nan(exponent_bits)) {
+            return;
+        }
+        Word magnitude = ((Word)exponent << mantissa_bits) | mantissa;
+        if (!sign) {
+            if (magnitude == 0) {
+                sign = true;
+                return;
+            }
+            magnitude--;
+        } else if (!is_inf(exponent_bits)) {
+            magnitude++;
+        }
+        set_magnitude(magnitude, mantissa_bits);
+    }
+
+  private:
+    static constexpr Word to_word(const Wide& wide) {
+        if constexpr (std::is_same_v<Word, Wide>) {
+            return wide;
+        } else {
+            return Traits::to_word(wide);
+        }
+    }
+
+    static constexpr bool is_odd(const Wide& wide) {
+        if constexpr (std::is_same_v<Wide, uint128_t>) {
+            return (wide & 1) != 0;
+        } else {
+            return !wide.is_even();
+        }
+    }
+
+    static constexpr Wide round_shift(const Wide& wide, long long shift) {
+        if (shift > Traits::bits) {
+            return Traits::from(0);
+        }
+        bool sticky = Traits::countr_zero(wide) < shift - 1;
+        Wide result = wide >> (int)(shift - 1);
+        bool round = is_odd(result);
+        result = result >> 1;
+        if (round && (sticky || is_odd(result))) {
+            result = result + Traits::from(1);
+        }
+        return result;
+    }
+
+    static constexpr Wide sticky_shift(const Wide& wide, long long shift) {
+        if (shift <= 0) {
+            return wide;
+        }
+        if (shift >= Traits::bits) {
+            return Traits::from(Traits::is_zero(wide) ? 0 : 1);
+        }
+        Wide result = wide >> (int)shift;
+        if (Traits::countr_zero(wide) < shift) {
+            result = result | Traits::from(1);
+        }
+        return result;
+    }
+
+    constexpr void set_magnitude(Word magnitude, int mantissa_bits) {
+        if constexpr (std::is_same_v<Word, Wide>) {
+            exponent = (magnitude >> mantissa_bits).to_int();
+        } else {
+            exponent = (long long)(magnitude >> mantissa_bits);
+        }
+        mantissa = magnitude & ((Word(1) << mantissa_bits) - 1);
+    }
+};
+
+using NativeFloat64 = NativeFloat<uint64_t, uint128_t>;
+using NativeFloat128 = NativeFloat<uint128_t, NativeWide256>;
+
+// Formats of up to 64 * word_count bits on static digits.
+template <int word_count>
+using NativeFloatWords = NativeFloat<StaticLongInt<2 * word_count, false, uint64_t>,
+                                     StaticLongInt<2 * word_count, false, uint64_t>>;
@@ -0,0 +1,243 @@
+#pragma once
+
+#include "NativeFloat.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// Arrays of a format with at most 32 bits, each value stored as its encoding in one uint32_t:
+// the sign at bit exponent_bits + mantissa_bits, then the exponent and the mantissa fields.
+// For float32 that is the IEEE bit pattern.
+//
+// Where double rounding is innocuous the operations run in double, lanes values at a time on
+// GCC vector extensions: the exact value of every operand is a double, and a result rounded to
+// double and then to the format equals the one rounded once, since 53 >= 2 * (mantissa_bits + 1)
+// + 2 and the format's range sits well inside the normal doubles. Other formats go through
+// NativeFloat64 one value at a time. Both need the default rounding and no -ffast-math.
+struct PackedFloats {
+    // As many 32-bit lanes as the widest integer vectors hold: wider vectors than the ISA has
+    // make GCC compare them lane by lane in scalar code.
+#if defined(__AVX512F__)
+    static constexpr int lanes = 16;
+#elif defined(__AVX2__)
+    static constexpr int lanes = 8;
+#else
+    static constexpr int lanes = 4;
+#endif
+
+    int exponent_bits = 0;
+    int mantissa_bits = 0;
+
+    static constexpr bool fits(int exponent_bits, int mantissa_bits) {
+        return exponent_bits >= 2 && mantissa_bits >= 1 && exponent_bits + mantissa_bits + 1 <= 32;
+    }
+
+    constexpr bool simd() const { return exponent_bits <= 10 && mantissa_bits <= 24; }
+
+    void add(const uint32_t* a, const uint32_t* b, uint32_t* result, size_t n) const {
+        binary<Op::add>(a, b, result, n);
+    }
+    void sub(const uint32_t* a, const uint32_t* b, uint32_t* result, size_t n) const {
+        binary<Op::sub>(a, b, result, n);
+    }
+    void mul(const uint32_t* a, const uint32_t* b, uint32_t* result, size_t n) const {
+        binary<Op::mul>(a, b, result, n);
+    }
+    void div(const uint32_t* a, const uint32_t* b, uint32_t* result, size_t n) const {
+        binary<Op::div>(a, b, result, n);
+    }
+
+    // In place, as float_next and float_prev. Only integer steps of the encoding, so every format
+    // that fits takes the vector path.
+    void next(uint32_t* values, size_t n) const { step<true>(values, n); }
+    void prev(uint32_t* values, size_t n) const { step<false>(values, n); }
+
+  private:
+    // The integer work is on 32-bit lanes: before SSE4.2 there is no compare of 64-bit lanes,
+    // and GCC falls back to scalar code for each one. Only shifts and the doubles are 64-bit.
+    typedef uint32_t Packed __attribute__((vector_size(lanes * sizeof(uint32_t))));
+    typedef int32_t Ints __attribute__((vector_size(lanes * sizeof(int32_t))));
+    typedef uint64_t Lanes __attribute__((vector_size(lanes * sizeof(uint64_t))));
+    typedef double Doubles __attribute__((vector_size(lanes * sizeof(double))));
+
+    enum class Op { add, sub, mul, div };
+
+    constexpr uint32_t sign_bit() const { return (uint32_t)1 << (exponent_bits + mantissa_bits); }
+    constexpr uint32_t max_exponent() const { return ((uint32_t)1 << exponent_bits) - 1; }
+    constexpr int32_t bias() const { return ((int32_t)1 << (exponent_bits - 1)) - 1; }
+    constexpr uint32_t mantissa_mask() const { return ((uint32_t)1 << mantissa_bits) - 1; }
+    constexpr uint32_t inf_bits() const { return max_exponent() << mantissa_bits; }
+    constexpr uint32_t nan_bits() const { return inf_bits() | ((uint32_t)1 << (mantissa_bits - 1)); }
+
+    // The helpers take and give vectors by reference: passed by value, the 64-bit ones are wider
+    // than the ISA's registers, which changes the calling convention, and GCC warns about it.
+    static void load(const uint32_t* values, Packed& packed) { __builtin_memcpy(&packed, values, sizeof(packed)); }
+    static void store(const Packed& packed, uint32_t* values) { __builtin_memcpy(values, &packed, sizeof(packed)); }
+
+    // mask ? a : b, lane by lane, for masks of all ones or zeros. Spelled out in bit operations,
+    // which measured faster than ?: on vectors without the SSE4.1 blends.
+    static Packed select(const Ints& mask, const Packed& a, const Packed& b) {
+        return ((Packed)mask & a) | (~(Packed)mask & b);
+    }
+
+    // The double whose high 32 bits are high and whose low ones are zero.
+    static void from_high(const Packed& high, Doubles& result) {
+        result = (Doubles)(__builtin_convertvector(high, Lanes) << 32);
+    }
+
+    // The exact value: real mantissa times a power of two, both exact doubles. Inf and NaN get
+    // a zero mantissa and the top exponent, with the quiet bit for NaN.
+    void to_double(const Packed& bits, Doubles& result) const {
+        Packed exponent = (bits >> mantissa_bits) & max_exponent();
+        Packed mantissa = bits & mantissa_mask();
+        Packed denormal = (Packed)(exponent == 0);
+        Packed special = (Packed)(exponent == max_exponent());
+        Packed real_mantissa = (mantissa | (~denormal & ((uint32_t)1 << mantissa_bits))) & ~special;
+        Packed real_exponent = exponent - denormal;
+
+        Doubles scale;
+        from_high((real_exponent + (uint32_t)(1023 - bias() - mantissa_bits)) << 20, scale);
+        // Real mantissas have at most 25 bits, and 32-bit integers convert to double in one instruction.
+        Doubles value = __builtin_convertvector((Ints)real_mantissa, Doubles) * scale;
+
+        Packed special_high = (Packed)(mantissa != 0) & 0x7ff80000;
+        special_high = (special_high | 0x7ff00000) & special;
+        Packed sign_high = (bits & sign_bit()) << (31 - exponent_bits - mantissa_bits);
+        Doubles high;
+        from_high(special_high | sign_high, high);
+        result = (Doubles)((Lanes)value | (Lanes)high);
+    }
+
+    // Rounds to nearest, ties to even, into the format. Adding 2^52 times the quantum of the
+    // value's binade, 2^(exponent - mantissa_bits) or the denormal one below the normals, leaves
+    // a sum whose ulp is that quantum, so the double unit does the rounding and subtracting it
+    // back is exact.
+    void from_double(const Doubles& value, Packed& result) const {
+        Lanes bits = (Lanes)value;
+        Packed high = __builtin_convertvector(bits >> 32, Packed);
+        Doubles magnitude = (Doubles)(bits & 0x7fffffffffffffff);
+
+        const int32_t min_exponent = 1023 + 1 - bias();
+        const int32_t max_exponent = 1023 + bias() + 1;
+        Ints exponent = (Ints)((high >> 20) & 0x7ff);
+        exponent = (Ints)select(exponent < min_exponent, (Packed){} + min_exponent, (Packed)exponent);
+        exponent = (Ints)select(exponent > max_exponent, (Packed){} + max_exponent, (Packed)exponent);
+        Doubles magic;
+        from_high((Packed)((exponent + (52 - mantissa_bits)) << 20), magic);
+        Doubles rounded = (magnitude + magic) - magic;
+
+        Lanes rounded_bits = (Lanes)rounded;
+        Ints rounded_exponent = (Ints)__builtin_convertvector(rounded_bits >> 52, Packed);
+        Packed normal = __builtin_convertvector(rounded_bits >> (52 - mantissa_bits), Packed) -
+                        ((uint32_t)(1023 - bias()) << mantissa_bits);
+        Doubles denormal_scale;
+        from_high((Packed){} + ((uint32_t)(1023 + bias() + mantissa_bits - 1) << 20), denormal_scale);
+        Packed denormal = (Packed)__builtin_convertvector(rounded * denormal_scale, Ints);
+
+        result = select(rounded_exponent >= min_exponent, normal, denormal);
+        result = select(rounded_exponent >= max_exponent, (Packed){} + inf_bits(), result);
+        result |= (high >> 31) << (exponent_bits + mantissa_bits);
+        // Arithmetic gives only quiet NaNs, which is all a NaN is checked by here.
+        result = select((Ints)(high & 0x7fffffff) >= 0x7ff80000, (Packed){} + nan_bits(), result);
+    }
+
+    // a and b are the lanes at a and b, result those at result, which may be either of them.
+    template <Op op> void apply(const uint32_t* a, const uint32_t* b, uint32_t* result) const {
+        Packed bits_a, bits_b;
+        load(a, bits_a);
+        load(b, bits_b);
+        Doubles x, y;
+        to_double(bits_a, x);
+        to_double(bits_b, y);
+        Doubles value;
+        if constexpr (op == Op::add) {
+            value = x + y;
+        } else if constexpr (op == Op::sub) {
+            value = x - y;
+        } else if constexpr (op == Op::mul) {
+            value = x * y;
+        } else {
+            value = x / y;
+        }
+
+        // A NaN operand comes back as it is, a first, as in floats.cpp. Magnitudes are below
+        // 2^31, so signed compares do.
+        Packed bits;
+        from_double(value, bits);
+        bits = select((Ints)(bits_b & ~sign_bit()) > (int32_t)inf_bits(), bits_b, bits);
+        bits = select((Ints)(bits_a & ~sign_bit()) > (int32_t)inf_bits(), bits_a, bits);
+        store(bits, result);
+    }
+
+    template <Op op> void binary(const uint32_t* a, const uint32_t* b, uint32_t* result, size_t n) const {
+        if (!simd()) {
+            for (size_t i = 0; i < n; ++i) {
+                result[i] = scalar<op>(a[i], b[i]);
+            }
+            return;
+        }
+
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            apply<op>(a + i, b + i, result + i);
+        }
+        if (i < n) {
+            uint32_t tail_a[lanes] = {}, tail_b[lanes] = {}, tail_result[lanes];
+            __builtin_memcpy(tail_a, a + i, (n - i) * sizeof(uint32_t));
+            __builtin_memcpy(tail_b, b + i, (n - i) * sizeof(uint32_t));
+            apply<op>(tail_a, tail_b, tail_result);
+            __builtin_memcpy(result + i, tail_result, (n - i) * sizeof(uint32_t));
+        }
+    }
+
+    template <Op op> uint32_t scalar(uint32_t a, uint32_t b) const {
+        auto unpack = [&](uint32_t bits) {
+            return NativeFloat64{(bool)(bits & sign_bit()), (long long)((bits >> mantissa_bits) & max_exponent()),
+                                 bits & mantissa_mask()};
+        };
+        NativeFloat64 x = unpack(a);
+        NativeFloat64 y = unpack(b);
+        NativeFloat64 value;
+        if constexpr (op == Op::add || op == Op::sub) {
+            value = NativeFloat64::add(x, y, op == Op::add ? y.sign : !y.sign, exponent_bits, mantissa_bits);
+        } else if constexpr (op == Op::mul) {
+            value = NativeFloat64::mul(x, y, exponent_bits, mantissa_bits);
+        } else {
+            value = NativeFloat64::div(x, y, exponent_bits, mantissa_bits);
+        }
+        return (value.sign ? sign_bit() : 0) | ((uint32_t)value.exponent << mantissa_bits) | (uint32_t)value.mantissa;
+    }
+
+    // The encoding without its sign steps by one ulp; the zeros step across the sign, and inf
+    // and NaN stay where next and prev leave them.
+    template <bool up> void step_lanes(uint32_t* values) const {
+        Packed bits;
+        load(values, bits);
+        Ints magnitude = (Ints)(bits & ~sign_bit());
+        Ints negative = (Ints)(bits & sign_bit()) != 0;
+        Ints away = up ? ~negative : negative;
+        const int32_t inf = (int32_t)inf_bits();
+
+        // away is all ones where the step grows the magnitude, so adding ~away | 1 steps by -1 or +1.
+        Ints stepped = magnitude + (~away | 1);
+        stepped = (Ints)select(away & (magnitude == inf), (Packed)magnitude, (Packed)stepped);
+        Packed result = (Packed)stepped | (bits & sign_bit());
+        // Towards zero from a zero: -0 goes to +0 on next and +0 to -0 on prev.
+        result = select(~away & (magnitude == 0), bits ^ sign_bit(), result);
+        result = select(magnitude > inf, bits, result);
+        store(result, values);
+    }
+
+    template <bool up> void step(uint32_t* values, size_t n) const {
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            step_lanes<up>(values + i);
+        }
+        if (i < n) {
+            uint32_t tail[lanes] = {};
+            __builtin_memcpy(tail, values + i, (n - i) * sizeof(uint32_t));
+            step_lanes<up>(tail);
+            __builtin_memcpy(values + i, tail, (n - i) * sizeof(uint32_t));
+        }
+    }
+};
@@ -0,0 +1,289 @@
+#pragma once
+
+#include "NativeFloat.hpp"
+
+#include <string_view>
+#include <type_traits>
+
+// The narrowest NativeFloat that holds a format of the given exponent and mantissa bits.
+template <int bits>
+using NativeFloatFor =
+    std::conditional_t<bits <= 64, NativeFloat64,
+                       std::conditional_t<bits <= 128, NativeFloat128, NativeFloatWords<(bits + 63) / 64>>>;
+
+// A Float whose format is part of its type. Every operation is constexpr and works on static
+// digits, so values of these types never touch the heap. The arithmetic is the NativeFloat code
+// float_add and the others dispatch to, with the same rounding and special values.
+template <int _exponent_bits, int _mantissa_bits> class StaticFloat {
+  public:
+    static constexpr int exponent_bits = _exponent_bits;
+    static constexpr int mantissa_bits = _mantissa_bits;
+
+    static_assert(exponent_bits >= 2 && exponent_bits <= 32, "The exponent must have from 2 to 32 bits");
+    static_assert(mantissa_bits >= 1, "The mantissa must have at least one bit");
+
+    using Native = NativeFloatFor<exponent_bits + mantissa_bits>;
+    using Word = decltype(Native::mantissa);
+
+    constexpr StaticFloat() = default;
+
+    // The stored fields, as float_set_sign, float_set_exponent and float_set_mantissa take them.
+    constexpr StaticFloat(bool sign, long long exponent, const Word& mantissa) : native{sign, exponent, mantissa} {}
+
+    constexpr bool sign() const { return native.sign; }
+    constexpr long long exponent() const { return native.exponent; }
+    constexpr const Word& mantissa() const { return native.mantissa; }
+
+    constexpr bool is_zero() const { return native.is_zero(); }
+    constexpr bool is_inf() const { return native.is_inf(exponent_bits); }
+    constexpr bool is_nan() const { return native.is_nan(exponent_bits); }
+
+    static constexpr StaticFloat inf(bool sign) { return StaticFloat(Native::inf(sign, exponent_bits)); }
+    static constexpr StaticFloat nan() { return StaticFloat(Native::nan(exponent_bits, mantissa_bits)); }
+
+    constexpr StaticFloat& next() {
+        native.next(exponent_bits, mantissa_bits);
+        return *this;
+    }
+
+    constexpr StaticFloat& prev() {
+        native.prev(exponent_bits, mantissa_bits);
+        return *this;
+    }
+
+    constexpr StaticFloat operator-() const {
+        StaticFloat result = *this;
+        result.native.sign = !result.native.sign;
+        return result;
+    }
+
+    friend constexpr StaticFloat operator+(const StaticFloat& a, const StaticFloat& b) {
+        return StaticFloat(Native::add(a.native, b.native, b.native.sign, exponent_bits, mantissa_bits));
+    }
+
+    friend constexpr StaticFloat operator-(const StaticFloat& a, const StaticFloat& b) {
+        return StaticFloat(Native::add(a.native, b.native, !b.native.sign, exponent_bits, mantissa_bits));
+    }
+
+    friend constexpr StaticFloat operator*(const StaticFloat& a, const StaticFloat& b) {
+        return StaticFloat(Native::mul(a.native, b.native, exponent_bits, mantissa_bits));
+    }
+
+    friend constexpr StaticFloat operator/(const StaticFloat& a, const StaticFloat& b) {
+        return StaticFloat(Native::div(a.native, b.native, exponent_bits, mantissa_bits));
+    }
+
+    // The same fields, so +0 and -0 differ and a NaN equals itself.
+    friend constexpr bool identical(const StaticFloat& a, const StaticFloat& b) {
+        return a.native.sign == b.native.sign && a.native.exponent == b.native.exponent &&
+               a.native.mantissa == b.native.mantissa;
+    }
+
+    // Decimal strings as in the tests, "-0.184656560E-25" or "174023074E26", and Inf or NaN in
+    // any case, rounded to nearest with ties to even. Anything else gives NaN.
+    static constexpr StaticFloat parse(std::string_view string);
+
+  private:
+    static constexpr long long bias = Native::bias(exponent_bits);
+
+    // A halfway point between two values of the format has at most this many significant
+    // decimal digits, so digits past them decide the rounding only by being nonzero.
+    static constexpr int parse_digits() {
+        return (int)(((mantissa_bits + 2) * 30103ll + (bias + mantissa_bits) * 69898ll) / 100000 + 2);
+    }
+
+    // A value of 10^max_decimal_exponent() or more overflows to inf, one below
+    // 10^min_decimal_exponent() rounds to zero.
+    static constexpr int max_decimal_exponent() { return (int)((bias + 1) * 30103 / 100000 + 1); }
+    static constexpr int min_decimal_exponent() { return (int)-((bias + mantissa_bits + 1) * 30103 / 100000 + 1); }
+
+    // Digits for the largest intermediate of parse: 10^-min_decimal_exponent() times all the
+    // digits, or a quotient of mantissa_bits + 3 bits shifted over that.
+    static constexpr int parse_words() {
+        long long decimals = std::max<long long>(max_decimal_exponent(), parse_digits() - min_decimal_exponent());
+        return (int)((decimals * 33220 / 10000 + mantissa_bits + 8) / 64 + 2);
+    }
+
+    explicit constexpr StaticFloat(const Native& native) : native(native) {}
+
+    static constexpr bool equal_ignore_case(std::string_view string, std::string_view lower) {
+        if (string.size() != lower.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < string.size(); ++i) {
+            char c = string[i] >= 'A' && string[i] <= 'Z' ? (char)(string[i] - 'A' + 'a') : string[i];
+            if (c != lower[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename Decimal> static constexpr Decimal pow10(long long power) {
+        Decimal result = 1;
+        Decimal base = 10;
+        while (power != 0) {
+            if (power & 1) {
+                result *= base;
+            }
+            power >>= 1;
+            if (power != 0) {
+                base *= base;
+            }
+        }
+        return result;
+    }
+
+    Native native;
+};
+
+template <int _exponent_bits, int _mantissa_bits>
+constexpr StaticFloat<_exponent_bits, _mantissa_bits>
+StaticFloat<_exponent_bits, _mantissa_bits>::parse(std::string_view string) {
+    static_assert(exponent_bits <= 16, "parse keeps exact intermediates only for exponents of up to 16 bits");
+    using Decimal = StaticLongInt<parse_words(), false, uint64_t>;
+
+    size_t i = 0;
+    bool sign = false;
+    if (i < string.size() && (string[i] == '+' || string[i] == '-')) {
+        sign = string[i++] == '-';
+    }
+    if (equal_ignore_case(string.substr(i), "inf") || equal_ignore_case(string.substr(i), "infinity")) {
+        return inf(sign);
+    }
+    if (equal_ignore_case(string.substr(i), "nan")) {
+        return nan();
+    }
+
+    // The value is digits * 10^decimal_exponent, and sticky is set when nonzero digits were
+    // dropped past parse_digits().
+    Decimal digits = 0;
+    int digit_count = 0;
+    long long decimal_exponent = 0;
+    bool sticky = false;
+    bool seen_digit = false;
+    bool seen_dot = false;
+
+    uint64_t chunk = 0;
+    int chunk_digits = 0;
+    // Digits go in 19 at a time, as many as a uint64_t chunk holds.
+    auto flush = [&]() {
+        uint64_t power = 1;
+        for (int k = 0; k < chunk_digits; ++k) {
+            power *= 10;
+        }
+        digits *= Decimal(power);
+        digits += Decimal(chunk);
+        chunk = 0;
+        chunk_digits = 0;
+    };
+
+    for (; i < string.size(); ++i) {
+        char c = string[i];
+        if (c == '.' && !seen_dot) {
+            seen_dot = true;
+            continue;
+        }
+        if (c < '0' || c > '9') {
+            break;
+        }
+        seen_digit = true;
+
+        if (digit_count == 0 && c == '0') {
+            decimal_exponent -= seen_dot;
+        } else if (digit_count < parse_digits()) {
+            chunk = chunk * 10 + (uint64_t)(c - '0');
+            digit_count++;
+            decimal_exponent -= seen_dot;
+            if (++chunk_digits == 19) {
+                flush();
+            }
+        } else {
+            sticky |= c != '0';
+            decimal_exponent += !seen_dot;
+        }
+    }
+    flush();
+
+    if (!seen_digit) {
+        return nan();
+    }
+    if (i < string.size() && (string[i] == 'e' || string[i] == 'E')) {
+        ++i;
+        bool exponent_sign = false;
+        if (i < string.size() && (string[i] == '+' || string[i] == '-')) {
+            exponent_sign = string[i++] == '-';
+        }
+        if (i == string.size()) {
+            return nan();
+        }
+        // Saturates far past any exponent that still changes the result.
+        long long exponent = 0;
+        for (; i < string.size() && string[i] >= '0' && string[i] <= '9'; ++i) {
+            exponent = std::min<long long>(exponent * 10 + (string[i] - '0'), 1ll << 40);
+        }
+        decimal_exponent += exponent_sign ? -exponent : exponent;
+    }
+    if (i != string.size()) {
+        return nan();
+    }
+
+    if (digit_count == 0) {
+        return StaticFloat(sign, 0, 0);
+    }
+    if (digit_count - 1 + decimal_exponent >= max_decimal_exponent()) {
+        return inf(sign);
+    }
+    if (digit_count + decimal_exponent < min_decimal_exponent()) {
+        return StaticFloat(sign, 0, 0);
+    }
+
+    // value = digits * 2^(exponent - bias - mantissa_bits), as NativeFloat::round takes it.
+    long long exponent = bias + mantissa_bits;
+    if (decimal_exponent >= 0) {
+        digits *= pow10<Decimal>(decimal_exponent);
+        if (sticky) {
+            digits <<= 1;
+            digits.get_digits()[0] |= 1;
+            exponent--;
+        }
+    } else {
+        // A quotient of mantissa_bits + 3 bits or more, with the remainder as a sticky bit.
+        Decimal divisor = pow10<Decimal>(-decimal_exponent);
+        int shift = std::max(0, mantissa_bits + 3 + digits.countl_zero() - divisor.countl_zero());
+        digits <<= shift;
+        exponent -= shift;
+
+        Decimal quotient = 0;
+        Decimal remainder = 0;
+        Decimal::divmod(digits, divisor, quotient, remainder);
+        digits = quotient;
+        if (sticky || !remainder.is_zero()) {
+            digits.get_digits()[0] |= 1;
+        }
+    }
+
+    // Down to mantissa_bits + 3 bits, keeping a sticky bit, so that it fits the Wide of round().
+    int excess = Decimal::get_digit_count() * 64 - digits.countl_zero() - (mantissa_bits + 3);
+    if (excess > 0) {
+        bool inexact = digits.countr_zero() < excess;
+        digits >>= excess;
+        exponent += excess;
+        if (inexact) {
+            digits.get_digits()[0] |= 1;
+        }
+    }
+
+    return StaticFloat(
+        Native::round_digits(sign, exponent, digits.get_digits(), Decimal::get_digit_count(), exponent_bits, mantissa_bits));
+}
+
+// IEEE-style formats: every one of them keeps inf and NaN at the top exponent, also e4m3,
+// which the OCP 8-bit spec defines without inf.
+using Float8E4M3 = StaticFloat<4, 3>;
+using Float8E5M2 = StaticFloat<5, 2>;
+using BFloat16 = StaticFloat<8, 7>;
+using Float16 = StaticFloat<5, 10>;
+using Float32 = StaticFloat<8, 23>;
+using Float64 = StaticFloat<11, 52>;
+using Float128 = StaticFloat<15, 112>;
@@ -1,4 +1,8 @@
 #include "floats.h"
+#include "Conversion.hpp"
+#include "FastDecimal.hpp"
+#include "NativeFloat.hpp"
+#include "PackedFloat.hpp"
 #include <iostream>
 #include <cmath>
 #include <limits.h>
@@ -17,19 +21,158 @@ BigInt& operator-=(BigInt& big_int, int val) {
   return big_int;
 }
 
+template <typename Native> Native load_native(const Float* self) {
+  Native native;
+  native.sign = self->sign;
+  native.exponent = (long long)self->exponent.get_digits()[0];
+  native.mantissa = Native::word_from_digits(self->mantissa.get_digits(), self->mantissa.get_digit_count());
+  return native;
+}
+
+template <typename Native> void store_native(Float* self, const Native& native) {
+  self->sign = native.sign;
+  self->exponent = (unsigned long long)native.exponent;
+  Native::word_to_digits(native.mantissa, self->mantissa.get_digits(), self->mantissa.get_digit_count());
+
+  if (native.exponent == 0) {
+    self->value = Float::Value::Denormal;
+  } else if (native.is_special(self->exponent_bits)) {
+    self->value = Float::Value::Special;
+  } else {
+    self->value = Float::Value::Normal;
+  }
+}
+
+template <typename Native> void native_add(Float* result, const Float* a, const Float* b) {
+  store_native(result, Native::add(load_native<Native>(a), load_native<Native>(b), b->sign, result->exponent_bits,
+                                   result->mantissa_bits));
+}
+
+template <typename Native> void native_sub(Float* result, const Float* a, const Float* b) {
+  store_native(result, Native::add(load_native<Native>(a), load_native<Native>(b), !b->sign, result->exponent_bits,
+                                   result->mantissa_bits));
+}
+
+template <typename Native> void native_mul(Float* result, const Float* a, const Float* b) {
+  store_native(result, Native::mul(load_native<Native>(a), load_native<Native>(b), result->exponent_bits,
+                                   result->mantissa_bits));
+}
+
+template <typename Native> void native_div(Float* result, const Float* a, const Float* b) {
+  store_native(result, Native::div(load_native<Native>(a), load_native<Native>(b), result->exponent_bits,
+                                   result->mantissa_bits));
+}
+
+template <typename Native> void native_next(Float* self) {
+  Native native = load_native<Native>(self);
+  native.next(self->exponent_bits, self->mantissa_bits);
+  store_native(self, native);
+}
+
+template <typename Native> void native_prev(Float* self) {
+  Native native = load_native<Native>(self);
+  native.prev(self->exponent_bits, self->mantissa_bits);
+  store_native(self, native);
+}
+
+struct FloatOps {
+  void (*add)(Float* result, const Float* a, const Float* b);
+  void (*sub)(Float* result, const Float* a, const Float* b);
+  void (*mul)(Float* result, const Float* a, const Float* b);
+  void (*div)(Float* result, const Float* a, const Float* b);
+  void (*next)(Float* self);
+  void (*prev)(Float* self);
+};
+
+// Arrays of formats that pack into 32 bits go through PackedFloats this many values at a time.
+constexpr size_t packed_block = 256;
+
+using BinaryOp = void (*)(Float* result, const Float* a, const Float* b);
+using UnaryOp = void (*)(Float* self);
+using PackedBinaryOp = void (PackedFloats::*)(const uint32_t* a, const uint32_t* b, uint32_t* result, size_t n) const;
+using PackedUnaryOp = void (PackedFloats::*)(uint32_t* values, size_t n) const;
+
+// Wider formats look their implementation up once for the whole array.
+void binary_n(Float* result, const Float* a, const Float* b, size_t n, PackedBinaryOp packed_op,
+              BinaryOp FloatOps::*op) {
+  if (n == 0) {
+    return;
+  }
+  PackedFloats packed = {result->exponent_bits, result->mantissa_bits};
+  if (!PackedFloats::fits(packed.exponent_bits, packed.mantissa_bits)) {
+    BinaryOp scalar_op = result->ops->*op;
+    for (size_t i = 0; i < n; i++) {
+      scalar_op(&result[i], &a[i], &b[i]);
+    }
+    return;
+  }
+
+  uint32_t packed_a[packed_block], packed_b[packed_block];
+  for (size_t start = 0; start < n; start += packed_block) {
+    size_t count = std::min(packed_block, n - start);
+    for (size_t i = 0; i < count; i++) {
+      packed_a[i] = (uint32_t)float_get_bits(&a[start + i]);
+      packed_b[i] = (uint32_t)float_get_bits(&b[start + i]);
+    }
+    (packed.*packed_op)(packed_a, packed_b, packed_a, count);
+    for (size_t i = 0; i < count; i++) {
+      float_set_bits(&result[start + i], packed_a[i]);
+    }
+  }
+}
+
+void unary_n(Float* self, size_t n, PackedUnaryOp packed_op, UnaryOp FloatOps::*op) {
+  if (n == 0) {
+    return;
+  }
+  PackedFloats packed = {self->exponent_bits, self->mantissa_bits};
+  if (!PackedFloats::fits(packed.exponent_bits, packed.mantissa_bits)) {
+    UnaryOp scalar_op = self->ops->*op;
+    for (size_t i = 0; i < n; i++) {
+      scalar_op(&self[i]);
+    }
+    return;
+  }
+
+  uint32_t values[packed_block];
+  for (size_t start = 0; start < n; start += packed_block) {
+    size_t count = std::min(packed_block, n - start);
+    for (size_t i = 0; i < count; i++) {
+      values[i] = (uint32_t)float_get_bits(&self[start + i]);
+    }
+    (packed.*packed_op)(values, count);
+    for (size_t i = 0; i < count; i++) {
+      float_set_bits(&self[start + i], values[i]);
+    }
+  }
+}
+
+template <typename Native>
+const FloatOps native_ops = {native_add<Native>, native_sub<Native>,  native_mul<Native>,
+                             native_div<Native>, native_next<Native>, native_prev<Native>};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #define size_of_uint64 64
 
+const FloatOps* select_ops(int exponent_bits, int mantissa_bits);
+
 void float_destroy(Float* self) {}
 
 int float_init(Float* self, int exponent_bits, int mantissa_bits) {
+  // Exponents are computed in long long.
+  if (exponent_bits < 2 || exponent_bits > 62 || mantissa_bits < 1) {
+    return -1;
+  }
+
   self->exponent_bits = exponent_bits;
   self->mantissa_bits = mantissa_bits;
-  self->size_of_big_int = 2 * (((exponent_bits + mantissa_bits) / size_of_uint64) +
-                               ((exponent_bits + mantissa_bits) % size_of_uint64 == 0 ? 0 : 1));
+  // Twice the digits of a packed value with its sign bit: the aligned sums and shifted
+  // dividends of the arithmetic take up to 2 * mantissa_bits + 5 bits.
+  int packed_bits = exponent_bits + mantissa_bits + 1;
+  self->size_of_big_int = 2 * ((packed_bits / size_of_uint64) + (packed_bits % size_of_uint64 == 0 ? 0 : 1));
 
   try {
     self->exponent = BigInt::with_digits(self->size_of_big_int);
@@ -53,8 +196,20 @@ int float_init(Float* self, int exponent_bits, int mantissa_bits) {
     return -1;
   }
 
+  // The operations keep their intermediates here, so that they allocate nothing. Division
+  // needs the digits of both operands and one more.
+  try {
+    self->scratch_lhs = BigInt::with_digits(self->size_of_big_int);
+    self->scratch_rhs = BigInt::with_digits(self->size_of_big_int);
+    self->scratch_remainder = BigInt::with_digits(self->size_of_big_int);
+    self->scratch_work = BigInt::with_digits(2 * self->size_of_big_int + 1);
+  } catch (...) {
+    return -1;
+  }
+
   self->value = Float::Value::Denormal;
   self->sign = false;
+  self->ops = select_ops(exponent_bits, mantissa_bits);
 
   return 0;
 }
@@ -109,169 +264,344 @@ void float_set_mantissa(Float* self, const void* mantissa) {
          (self->mantissa_bits / CHAR_BIT) + (self->mantissa_bits % CHAR_BIT == 0 ? 0 : 1));
 }
 
-bool find_bit(BigInt* big_int, int shift) {
-  *big_int >>= (shift - 1);
-  bool res = !big_int->is_even();
-  *big_int >>= 1;
-  return res;
+uint64_t float_get_bits(const Float* self) {
+  assert(self->exponent_bits + self->mantissa_bits < 64);
+  return ((uint64_t)self->sign << (self->exponent_bits + self->mantissa_bits)) |
+         (self->exponent.get_digits()[0] << self->mantissa_bits) | self->mantissa.get_digits()[0];
 }
 
-void norm(Float* self) {
-  bool last_bit = false;
+void float_set_bits(Float* self, uint64_t bits) {
+  assert(self->exponent_bits + self->mantissa_bits < 64);
+  uint64_t max_exponent = ((uint64_t)1 << self->exponent_bits) - 1;
+  uint64_t exponent = (bits >> self->mantissa_bits) & max_exponent;
+  self->sign = (bits >> (self->exponent_bits + self->mantissa_bits)) & 1;
+  self->exponent = exponent;
+  self->mantissa = bits & (((uint64_t)1 << self->mantissa_bits) - 1);
 
-  if (!self->mantissa.is_zero()) {
-    int pos = self->size_of_big_int * size_of_uint64 - self->mantissa.countl_zero() - self->mantissa_bits - 1;
+  if (exponent == 0) {
+    self->value = Float::Value::Denormal;
+  } else if (exponent == max_exponent) {
+    self->value = Float::Value::Special;
+  } else {
+    self->value = Float::Value::Normal;
+  }
+}
 
-    if (pos >= 0) {
-      last_bit = find_bit(&self->mantissa, pos);
-      self->exponent += pos;
+long long max_exponent(const Float* self) {
+  return (1ll << self->exponent_bits) - 1;
+}
 
-      if (!self->exponent.is_zero() && !self->exponent.is_negative()) {
-        self->mantissa -= self->pow_2_mantissa_bits;
-        self->value = Float::Value::Normal;
-      }
-    } else {
-      pos *= -1;
-      self->mantissa <<= pos;
-      self->exponent -= pos;
+long long bias(const Float* self) {
+  return (1ll << (self->exponent_bits - 1)) - 1;
+}
 
-      if (!self->exponent.is_zero() && !self->exponent.is_negative()) {
-        self->mantissa -= self->pow_2_mantissa_bits;
-        self->value = Float::Value::Normal;
-      }
-    }
-  }
+bool is_zero(const Float* self) {
+  return self->exponent.is_zero() && self->mantissa.is_zero();
+}
 
-  if (self->exponent.is_negative() || self->exponent.is_zero()) {
-    last_bit = find_bit(&self->mantissa, 1 - self->exponent.to_int());
-    self->exponent = 0;
-    self->value = Float::Value::Denormal;
+bool is_inf(const Float* self) {
+  return self->value == Float::Value::Special && self->mantissa.is_zero();
+}
+
+bool is_nan(const Float* self) {
+  return self->value == Float::Value::Special && !self->mantissa.is_zero();
+}
+
+void set_nan(Float* self) {
+  self->exponent = (unsigned long long)max_exponent(self);
+  self->mantissa = 1;
+  self->mantissa <<= (self->mantissa_bits - 1);
+  self->sign = false;
+  self->value = Float::Value::Special;
+}
+
+void set_inf(Float* self, bool sign) {
+  self->exponent = (unsigned long long)max_exponent(self);
+  self->mantissa = 0;
+  self->sign = sign;
+  self->value = Float::Value::Special;
+}
+
+void set_zero(Float* self, bool sign) {
+  self->exponent = 0;
+  self->mantissa = 0;
+  self->sign = sign;
+  self->value = Float::Value::Denormal;
+}
+
+void copy_float(Float* self, const Float* other) {
+  if (self != other) {
+    self->exponent = other->exponent;
+    self->mantissa = other->mantissa;
+    self->sign = other->sign;
+    self->value = other->value;
   }
+}
 
-  if (last_bit) {
-    self->mantissa += 1;
+// Loads the mantissa with its implicit bit and returns the exponent it is scaled by, which
+// is 1 for denormals. Copies into preallocated digits, so nothing is allocated.
+long long unpack(const Float* self, BigInt* mantissa) {
+  *mantissa = self->mantissa;
+  if (self->value == Float::Value::Normal) {
+    *mantissa += self->pow_2_mantissa_bits;
+    return (long long)self->exponent.get_digits()[0];
   }
+  return 1;
+}
 
-  if (self->mantissa == self->pow_2_mantissa_bits) {
-    self->exponent += 1;
-    self->mantissa = 0;
-    self->value = Float::Value::Normal;
+// Shifts right by shift bits, rounding to nearest with ties to even: the last bit shifted
+// out decides, and the ones below it break a tie.
+void round_shift(BigInt* big_int, long long shift) {
+  if (shift <= 0) {
+    return;
   }
+  shift = std::min<long long>(shift, (long long)big_int->get_digit_count() * size_of_uint64 + 1);
 
-  BigInt big_exp = get_big_exp(self);
-  if (self->exponent >= big_exp) {
-    self->exponent = big_exp;
-    self->mantissa = 0;
-    self->value = Float::Value::Special;
+  bool sticky = big_int->countr_zero() < shift - 1;
+  *big_int >>= (int)(shift - 1);
+  bool round = !big_int->is_even();
+  *big_int >>= 1;
+
+  if (round && (sticky || !big_int->is_even())) {
+    ++*big_int;
   }
 }
 
-void float_add(Float* result, const Float* a, const Float* b) {
-  // TODO
+// Shifts right by shift bits and sets the lowest bit if any bit shifted out was set, so that
+// a later round_shift by at least one more bit still sees them.
+void sticky_shift(BigInt* big_int, long long shift) {
+  if (shift <= 0) {
+    return;
+  }
+  shift = std::min<long long>(shift, (long long)big_int->get_digit_count() * size_of_uint64);
+
+  bool sticky = big_int->countr_zero() < shift;
+  *big_int >>= (int)shift;
+  if (sticky) {
+    big_int->get_digits()[0] |= 1;
+  }
 }
 
-void float_sub(Float* result, const Float* a, const Float* b) {
-  // TODO
+// The last step of every operation. self->mantissa holds a mantissa of any length with the
+// implicit bit included, worth mantissa * 2^(exponent - bias - mantissa_bits); it is
+// normalized and rounded once, to nearest with ties to even, into the format.
+void norm(Float* self, bool sign, long long exponent) {
+  self->sign = sign;
+  if (self->mantissa.is_zero()) {
+    set_zero(self, sign);
+    return;
+  }
+
+  long long pos = self->size_of_big_int * size_of_uint64 - self->mantissa.countl_zero() - self->mantissa_bits - 1;
+  exponent += pos;
+
+  bool denormal = exponent <= 0;
+  if (denormal) {
+    // A denormal is scaled as exponent 1 without the implicit bit.
+    pos += 1 - exponent;
+    exponent = 0;
+  }
+
+  if (pos >= 0) {
+    round_shift(&self->mantissa, pos);
+  } else {
+    self->mantissa <<= (int)-pos;
+  }
+
+  if (denormal) {
+    self->value = Float::Value::Denormal;
+    if (self->mantissa == self->pow_2_mantissa_bits) {
+      exponent = 1;
+      self->mantissa = 0;
+      self->value = Float::Value::Normal;
+    }
+  } else {
+    // Rounding up may carry into a bit above the implicit one.
+    if (self->mantissa.countl_zero() < self->size_of_big_int * size_of_uint64 - self->mantissa_bits - 1) {
+      self->mantissa >>= 1;
+      exponent++;
+    }
+    self->mantissa -= self->pow_2_mantissa_bits;
+    self->value = Float::Value::Normal;
+  }
+
+  if (exponent >= max_exponent(self)) {
+    set_inf(self, sign);
+    return;
+  }
+  self->exponent = (unsigned long long)exponent;
 }
 
-bool mul_special(Float* result, const Float* a, const Float* b) {
-  if ((a->exponent.is_zero() && a->mantissa.is_zero() &&
-       b->value == Float::Value::Special && b->mantissa.is_zero()) ||
-      (b->exponent.is_zero() && b->mantissa.is_zero() &&
-       a->value == Float::Value::Special && a->mantissa.is_zero())) {
-    result->exponent = get_big_exp(result);
-
-    result->mantissa = 1;
-    result->mantissa <<= (result->mantissa_bits - 1);
-    result->sign = false;
-    result->value = Float::Value::Special;
+bool add_special(Float* result, const Float* a, const Float* b, bool b_sign) {
+  if (is_nan(a)) {
+    copy_float(result, a);
     return true;
   }
-
-  if (a->value == Float::Value::Special && !a->mantissa.is_zero()) {
-    result->mantissa = a->mantissa;
-    result->exponent = a->exponent;
-    result->sign = a->sign;
-    result->value = Float::Value::Special;
+  if (is_nan(b)) {
+    copy_float(result, b);
     return true;
   }
 
-  if (b->value == Float::Value::Special && !b->mantissa.is_zero()) {
-    result->mantissa = b->mantissa;
-    result->exponent = b->exponent;
-    result->sign = b->sign;
-    result->value = Float::Value::Special;
+  if (is_inf(a) && is_inf(b) && a->sign != b_sign) {
+    set_nan(result);
     return true;
   }
-
-  if (a->value == Float::Value::Special && a->mantissa.is_zero()) {
-    result->exponent = a->exponent;
-    result->mantissa = 0;
-    result->sign = a->sign ^ b->sign;
-    result->value = Float::Value::Special;
+  if (is_inf(a)) {
+    set_inf(result, a->sign);
     return true;
   }
-
-  if (b->value == Float::Value::Special && b->mantissa.is_zero()) {
-    result->exponent = b->exponent;
-    result->mantissa = 0;
-    result->sign = a->sign ^ b->sign;
-    result->value = Float::Value::Special;
+  if (is_inf(b)) {
+    set_inf(result, b_sign);
     return true;
   }
 
+  if (is_zero(a) && is_zero(b)) {
+    set_zero(result, a->sign && b_sign);
+    return true;
+  }
   return false;
 }
 
-BigInt get_real_exp(const Float* self) {
-  BigInt exp = (BigInt::with_digits(self->size_of_big_int) = 0);
+// a + b with b's sign taken as b_sign. The operand with the larger exponent is shifted left
+// by the difference, or by mantissa_bits + 2 when that is less, and the other one right by
+// the rest with the bits shifted out kept as a sticky bit. The exact sum then differs from
+// the computed one only below the rounding bit.
+void add_signed(Float* result, const Float* a, const Float* b, bool b_sign) {
+  if (add_special(result, a, b, b_sign)) {
+    return;
+  }
 
-  if (self->value == Float::Value::Normal) {
-    exp += self->exponent;
+  BigInt* high = &result->scratch_lhs;
+  BigInt* low = &result->scratch_rhs;
+  long long exponent_a = unpack(a, high);
+  long long exponent_b = unpack(b, low);
+  bool high_sign = a->sign;
+  bool low_sign = b_sign;
+  if (exponent_a < exponent_b) {
+    std::swap(high, low);
+    std::swap(exponent_a, exponent_b);
+    std::swap(high_sign, low_sign);
+  }
+
+  long long difference = exponent_a - exponent_b;
+  long long shift = std::min<long long>(difference, result->mantissa_bits + 2);
+  *high <<= (int)shift;
+  sticky_shift(low, difference - shift);
+  long long exponent = exponent_a - shift;
+
+  bool sign = high_sign;
+  if (high_sign == low_sign) {
+    result->mantissa = *high;
+    result->mantissa += *low;
+  } else if (*low < *high) {
+    result->mantissa = *high;
+    result->mantissa -= *low;
   } else {
-    exp += 1;
+    // An exact cancellation gives +0.
+    result->mantissa = *low;
+    result->mantissa -= *high;
+    sign = result->mantissa.is_zero() ? false : low_sign;
   }
 
-  return exp;
+  norm(result, sign, exponent);
 }
 
-BigInt get_real_mant(const Float* self) {
-  BigInt mant = self->mantissa;
-  if (self->value == Float::Value::Normal) {
-    mant += self->pow_2_mantissa_bits;
+void dynamic_add(Float* result, const Float* a, const Float* b) {
+  add_signed(result, a, b, b->sign);
+}
+
+void dynamic_sub(Float* result, const Float* a, const Float* b) {
+  add_signed(result, a, b, !b->sign);
+}
+
+bool mul_special(Float* result, const Float* a, const Float* b) {
+  if ((is_zero(a) && is_inf(b)) || (is_zero(b) && is_inf(a))) {
+    set_nan(result);
+    return true;
   }
 
-  return mant;
+  if (is_nan(a)) {
+    copy_float(result, a);
+    return true;
+  }
+  if (is_nan(b)) {
+    copy_float(result, b);
+    return true;
+  }
+
+  if (is_inf(a) || is_inf(b)) {
+    set_inf(result, a->sign ^ b->sign);
+    return true;
+  }
+
+  return false;
 }
 
-void float_mul(Float* result, const Float* a, const Float* b) {
+void dynamic_mul(Float* result, const Float* a, const Float* b) {
   if (mul_special(result, a, b)) {
     return;
   }
 
-  result->sign = a->sign ^ b->sign;
+  long long exponent = unpack(a, &result->scratch_lhs) + unpack(b, &result->scratch_rhs);
+  exponent -= bias(result) + result->mantissa_bits;
 
-  BigInt m_bits = BigInt::with_digits(result->size_of_big_int);
-  m_bits = a->mantissa_bits;
+  BigInt::mul_to(result->scratch_lhs, result->scratch_rhs, result->mantissa);
+  norm(result, a->sign ^ b->sign, exponent);
+}
 
-  BigInt b_denumerator = BigInt::with_digits(result->size_of_big_int);
-  b_denumerator = 1;
-  b_denumerator <<= (b->exponent_bits - 1);
-  b_denumerator = -b_denumerator;
+bool div_special(Float* result, const Float* a, const Float* b) {
+  if ((is_zero(a) && is_zero(b)) || (is_inf(a) && is_inf(b))) {
+    set_nan(result);
+    return true;
+  }
 
-  BigInt b_exp = ((get_real_exp(b) += b_denumerator) += 1);
-  result->exponent = get_real_exp(a) + b_exp - m_bits;
+  if (is_nan(a)) {
+    copy_float(result, a);
+    return true;
+  }
+  if (is_nan(b)) {
+    copy_float(result, b);
+    return true;
+  }
 
-  result->mantissa = get_real_mant(a) * get_real_mant(b);
+  if (is_inf(a) || is_zero(b)) {
+    set_inf(result, a->sign ^ b->sign);
+    return true;
+  }
+  if (is_inf(b) || is_zero(a)) {
+    set_zero(result, a->sign ^ b->sign);
+    return true;
+  }
 
-  norm(result);
+  return false;
 }
 
-void float_div(Float* result, const Float* a, const Float* b) {
-  // TODO
+void dynamic_div(Float* result, const Float* a, const Float* b) {
+  if (div_special(result, a, b)) {
+    return;
+  }
+
+  bool sign = a->sign ^ b->sign;
+  BigInt* mant_a = &result->scratch_lhs;
+  BigInt* mant_b = &result->scratch_rhs;
+  long long exponent = unpack(a, mant_a) - unpack(b, mant_b);
+
+  // The quotient gets mantissa_bits + 3 bits at least: the kept ones, the rounding bit and one
+  // more below it, set when the division is inexact, so that norm rounds a true tie only.
+  int shift = result->mantissa_bits + 3 + mant_a->countl_zero() - mant_b->countl_zero();
+  *mant_a <<= shift;
+  exponent += bias(result) + result->mantissa_bits - shift;
+
+  BigInt::divmod_to(*mant_a, *mant_b, result->mantissa, result->scratch_remainder,
+                    result->scratch_work.get_digits());
+  if (!result->scratch_remainder.is_zero()) {
+    result->mantissa.get_digits()[0] |= 1;
+  }
+
+  norm(result, sign, exponent);
 }
 
-void float_next(Float* self) {
+void dynamic_next(Float* self) {
   if (self->value == Float::Value::Special) {
     if (self->mantissa.is_zero() && self->sign) {
       self->sign = true;
@@ -331,7 +661,7 @@ void float_next(Float* self) {
   }
 }
 
-void float_prev(Float* self) {
+void dynamic_prev(Float* self) {
   if (self->value == Float::Value::Special) {
     if (self->mantissa.is_zero() && !self->sign) {
       self->sign = false;
@@ -391,13 +721,383 @@ void float_prev(Float* self) {
   }
 }
 
+const FloatOps dynamic_ops = {dynamic_add, dynamic_sub, dynamic_mul, dynamic_div, dynamic_next, dynamic_prev};
+
+// Wider formats stay on the in-place LongInt pipeline: NativeFloatWords, which StaticFloat
+// uses past 128 bits, copies whole values and measures about 1.7 times slower there.
+// FLOATS_NO_NATIVE keeps every format on LongInt digits, for comparison.
+const FloatOps* select_ops(int exponent_bits, int mantissa_bits) {
+#ifndef FLOATS_NO_NATIVE
+  if (NativeFloat64::fits(exponent_bits, mantissa_bits)) {
+    return &native_ops<NativeFloat64>;
+  }
+  if (NativeFloat128::fits(exponent_bits, mantissa_bits)) {
+    return &native_ops<NativeFloat128>;
+  }
+#endif
+  return &dynamic_ops;
+}
+
+void float_add(Float* result, const Float* a, const Float* b) {
+  result->ops->add(result, a, b);
+}
+
+void float_sub(Float* result, const Float* a, const Float* b) {
+  result->ops->sub(result, a, b);
+}
+
+void float_mul(Float* result, const Float* a, const Float* b) {
+  result->ops->mul(result, a, b);
+}
+
+void float_div(Float* result, const Float* a, const Float* b) {
+  result->ops->div(result, a, b);
+}
+
+void float_next(Float* self) {
+  self->ops->next(self);
+}
+
+void float_prev(Float* self) {
+  self->ops->prev(self);
+}
+
+void float_add_n(Float* result, const Float* a, const Float* b, size_t n) {
+  binary_n(result, a, b, n, &PackedFloats::add, &FloatOps::add);
+}
+
+void float_sub_n(Float* result, const Float* a, const Float* b, size_t n) {
+  binary_n(result, a, b, n, &PackedFloats::sub, &FloatOps::sub);
+}
+
+void float_mul_n(Float* result, const Float* a, const Float* b, size_t n) {
+  binary_n(result, a, b, n, &PackedFloats::mul, &FloatOps::mul);
+}
+
+void float_div_n(Float* result, const Float* a, const Float* b, size_t n) {
+  binary_n(result, a, b, n, &PackedFloats::div, &FloatOps::div);
+}
+
+void float_next_n(Float* self, size_t n) {
+  unary_n(self, n, &PackedFloats::next, &FloatOps::next);
+}
+
+void float_prev_n(Float* self, size_t n) {
+  unary_n(self, n, &PackedFloats::prev, &FloatOps::prev);
+}
+
+// The exact conversions, for formats past 64 bits and for the few values FastDecimal leaves:
+// BigInt integers of as many digits as the value needs, sized per call, and a DynNum for the
+// printed digits. FLOATS_NO_FAST_DECIMAL takes them for every format, for comparison.
+
+// Digits for decimals decimal digits and a quotient of mantissa_bits + 3 bits shifted over them.
+int decimal_words(const Float* self, long long decimals) {
+  return (int)((decimals * 33220 / 10000 + self->mantissa_bits + 8) / size_of_uint64 + 2);
+}
+
+BigInt pow10(int words, long long power) {
+  BigInt result(words, 1);
+  BigInt base(words, 10);
+  while (power != 0) {
+    if (power & 1) {
+      result *= base;
+    }
+    power >>= 1;
+    if (power != 0) {
+      base *= base;
+    }
+  }
+  return result;
+}
+
+// Whether self is the largest finite value of its format, of either sign.
+bool is_largest(const Float* self) {
+  BigInt all_ones = self->pow_2_mantissa_bits;
+  all_ones -= 1;
+  return self->value == Float::Value::Normal &&
+         (long long)self->exponent.get_digits()[0] == max_exponent(self) - 1 && self->mantissa == all_ones;
+}
+
+// The digits of number rounded into the format, as StaticFloat::parse does on static digits.
+void exact_parse(Float* self, const DecimalString* number) {
+  bool sign = number->sign;
+  if (number->digit_count == 0) {
+    set_zero(self, sign);
+    return;
+  }
+
+  // A value of 10^max_decimal or more overflows to inf, one below 10^min_decimal rounds to
+  // zero, and a halfway point between two values has at most parse_digits significant digits.
+  long long max_decimal = (bias(self) + 1) * 30103 / 100000 + 1;
+  long long min_decimal = -((bias(self) + self->mantissa_bits + 1) * 30103 / 100000 + 1);
+  long long parse_digits = ((self->mantissa_bits + 2) * 30103ll + (bias(self) + self->mantissa_bits) * 69898ll) / 100000 + 2;
+  if (number->digit_count - 1 + number->exponent >= max_decimal) {
+    set_inf(self, sign);
+    return;
+  }
+  if (number->digit_count + number->exponent < min_decimal) {
+    set_zero(self, sign);
+    return;
+  }
+
+  // The value is digits * 10^decimal_exponent, and sticky is set when nonzero digits were
+  // dropped past parse_digits.
+  long long kept = std::min(number->digit_count, parse_digits);
+  long long decimal_exponent = number->exponent + (number->digit_count - kept);
+  int words = decimal_words(self, kept + std::abs(decimal_exponent));
+  BigInt digits(words, 0);
+  bool sticky = false;
+
+  uint64_t chunk = 0;
+  uint64_t chunk_power = 1;
+  long long count = 0;
+  // Digits go in 19 at a time, as many as a uint64_t chunk holds.
+  auto flush = [&]() {
+    digits *= BigInt(words, chunk_power);
+    digits += BigInt(words, chunk);
+    chunk = 0;
+    chunk_power = 1;
+  };
+  for (char c : number->mantissa) {
+    if (c == '.') {
+      continue;
+    }
+    if (count == kept) {
+      sticky |= c != '0';
+      continue;
+    }
+    chunk = chunk * 10 + (uint64_t)(c - '0');
+    chunk_power *= 10;
+    if (++count % 19 == 0) {
+      flush();
+    }
+  }
+  flush();
+  BigInt decimal = digits;
+
+  long long exponent = bias(self) + self->mantissa_bits;
+  if (decimal_exponent >= 0) {
+    digits *= pow10(words, decimal_exponent);
+    if (sticky) {
+      digits <<= 1;
+      digits.get_digits()[0] |= 1;
+      exponent--;
+    }
+  } else {
+    // A quotient of mantissa_bits + 3 bits or more, with the remainder as a sticky bit.
+    BigInt divisor = pow10(words, -decimal_exponent);
+    int shift = std::max(0, self->mantissa_bits + 3 + digits.countl_zero() - divisor.countl_zero());
+    digits <<= shift;
+    exponent -= shift;
+
+    BigInt quotient = BigInt::as(digits);
+    BigInt remainder = BigInt::as(digits);
+    BigInt::divmod(digits, divisor, quotient, remainder);
+    digits = quotient;
+    if (sticky || !remainder.is_zero()) {
+      digits.get_digits()[0] |= 1;
+    }
+  }
+
+  // Down to mantissa_bits + 3 bits, keeping a sticky bit, so that it fits the mantissa for norm().
+  int excess = words * size_of_uint64 - digits.countl_zero() - (self->mantissa_bits + 3);
+  if (excess > 0) {
+    sticky_shift(&digits, excess);
+    exponent += excess;
+  }
+  for (int i = 0; i < self->size_of_big_int; i++) {
+    self->mantissa.get_digits()[i] = i < words ? digits.get_digits()[i] : 0;
+  }
+  norm(self, sign, exponent);
+
+  // Anything past the largest finite value is inf, also what would round down to it.
+  if (is_largest(self)) {
+    // decimal * 10^decimal_exponent against (2^(mantissa_bits + 1) - 1) * 2^binary_exponent.
+    long long binary_exponent = max_exponent(self) - 1 - bias(self) - self->mantissa_bits;
+    int wide_words = words + (int)((std::abs(binary_exponent) + self->mantissa_bits) / size_of_uint64 + 2);
+    BigInt value(wide_words, 0), largest(wide_words, 1);
+    for (int i = 0; i < words; i++) {
+      value.get_digits()[i] = decimal.get_digits()[i];
+    }
+    largest <<= self->mantissa_bits + 1;
+    largest -= 1;
+    if (decimal_exponent >= 0) {
+      value *= pow10(wide_words, decimal_exponent);
+    } else {
+      largest *= pow10(wide_words, -decimal_exponent);
+    }
+    if (binary_exponent >= 0) {
+      largest <<= (int)binary_exponent;
+    } else {
+      value <<= (int)-binary_exponent;
+    }
+    if (value > largest || (value == largest && sticky)) {
+      set_inf(self, sign);
+    }
+  }
+}
+
+// The shortest digits that round back to a finite nonzero self, the closest of them with ties
+// to an even last digit: free-format digit generation after Steele and White, on r / s with
+// the halfway points to the neighbours at (r + plus) / s and (r - minus) / s.
+void exact_shortest(const Float* self, DynNum<>* number) {
+  BigInt mantissa = self->mantissa;
+  long long exponent = unpack(self, &mantissa) - bias(self) - self->mantissa_bits;
+  // The halfway point below is nearer for the first value of a binade past the denormals, and
+  // past the largest finite value float_parse overflows, so that one is its own bound above.
+  long long biased_exponent = (long long)self->exponent.get_digits()[0];
+  int unequal = self->mantissa.is_zero() && biased_exponent > 1;
+  bool largest = is_largest(self);
+  bool inclusive_below = mantissa.is_even();
+  bool inclusive_above = inclusive_below || largest;
+
+  long long magnitude = std::abs(exponent) + self->mantissa_bits + 1;
+  int words = (int)((2 * magnitude + 16) / size_of_uint64 + 2);
+  BigInt r(words, 0), s(words, 1), plus(words, 1), minus(words, 1);
+  for (int i = 0; i < self->size_of_big_int; i++) {
+    r.get_digits()[i] = mantissa.get_digits()[i];
+  }
+  if (exponent >= 0) {
+    r <<= (int)(exponent + 1 + unequal);
+    s <<= 1 + unequal;
+    plus <<= (int)(exponent + unequal);
+    minus <<= (int)exponent;
+  } else {
+    r <<= 1 + unequal;
+    s <<= (int)(1 - exponent + unequal);
+    plus <<= unequal;
+  }
+  if (largest) {
+    plus = 0;
+  }
+
+  // 10^(k - 1) <= r / s < 10^k, from floor(log2(value) * log10(2)) and fixed up below.
+  long long log2 = self->size_of_big_int * size_of_uint64 - mantissa.countl_zero() - 1 + exponent;
+  long long k = (long long)std::floor((double)log2 * 0.30102999566398120) + 1;
+  if (k >= 0) {
+    s *= pow10(words, k);
+  } else {
+    BigInt scale = pow10(words, -k);
+    r *= scale;
+    plus *= scale;
+    minus *= scale;
+  }
+
+  BigInt ten(words, 10);
+  auto reaches = [&](const BigInt& value, const BigInt& bound) {
+    return inclusive_above ? value >= bound : value > bound;
+  };
+  while (reaches(r + plus, s)) {
+    s *= ten;
+    k++;
+  }
+  while (!reaches((r + plus) * ten, s)) {
+    r *= ten;
+    plus *= ten;
+    minus *= ten;
+    k--;
+  }
+
+  std::string digits;
+  for (;;) {
+    r *= ten;
+    plus *= ten;
+    minus *= ten;
+    int digit = 0;
+    while (r >= s) {
+      r -= s;
+      digit++;
+    }
+
+    bool low = inclusive_below ? r <= minus : r < minus;
+    bool high = reaches(r + plus, s);
+    if (low && high) {
+      BigInt twice = r << 1;
+      if (twice > s || (twice == s && digit % 2 != 0)) {
+        digit++;
+      }
+    } else if (high) {
+      digit++;
+    }
+    digits.push_back((char)('0' + digit));
+    if (low || high) {
+      break;
+    }
+  }
+
+  *number = DynNum<>(self->sign, (int)k, digits);
+}
+
 void float_parse(Float* self, const char* string) {
-  // TODO
+  DecimalString number = DecimalString::scan(string);
+  if (number.kind == DecimalString::Kind::NaN) {
+    set_nan(self);
+    return;
+  }
+  if (number.kind == DecimalString::Kind::Inf) {
+    set_inf(self, number.sign);
+    return;
+  }
+
+#ifndef FLOATS_NO_FAST_DECIMAL
+  NativeFloat64 native;
+  if (FastDecimal::fits(self->exponent_bits, self->mantissa_bits) &&
+      FastDecimal::parse(number, self->exponent_bits, self->mantissa_bits, native)) {
+    store_native(self, native);
+    return;
+  }
+#endif
+  exact_parse(self, &number);
 }
 
+// Writes the shortest decimal that float_parse reads back as self, in the layout of
+// Conversion::string: "Inf", "-Inf", "NaN", "-0", "0.5", "15E2" or "0.123E-2". Like
+// snprintf it returns the full length and writes at most n characters, followed by a null
+// one when there is room, so float_string(self, nullptr, 0) measures the string.
 int float_string(const Float* self, char* string, int n) {
-  // TODO
-  return 0;
+  // Up to 40 digits of FastDecimal and the decoration around them.
+  char buffer[40 + Conversion::max_decoration];
+  std::string text;
+  const char* result = buffer;
+  int length = -1;
+
+  if (is_nan(self)) {
+    result = "NaN";
+    length = 3;
+  } else if (is_inf(self)) {
+    result = self->sign ? "-Inf" : "Inf";
+    length = self->sign ? 4 : 3;
+  } else if (is_zero(self)) {
+    result = self->sign ? "-0" : "0";
+    length = self->sign ? 2 : 1;
+  }
+
+#ifndef FLOATS_NO_FAST_DECIMAL
+  char digits[40];
+  int count = 0;
+  int dot_index = 0;
+  if (length < 0 && FastDecimal::fits(self->exponent_bits, self->mantissa_bits) &&
+      FastDecimal::shortest(load_native<NativeFloat64>(self), self->exponent_bits, self->mantissa_bits, digits,
+                            count, dot_index)) {
+    length = Conversion::write(self->sign, digits, count, dot_index, buffer);
+  }
+#endif
+
+  if (length < 0) {
+    DynNum<> number;
+    exact_shortest(self, &number);
+    text = Conversion::string(number);
+    result = text.data();
+    length = (int)text.size();
+  }
+
+  if (string != nullptr) {
+    std::copy(result, result + std::min(length, n), string);
+    if (length < n) {
+      string[length] = '\0';
+    }
+  }
+  return length;
 }
 
 #ifdef __cplusplus
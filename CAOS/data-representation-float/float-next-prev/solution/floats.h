@@ -8,6 +8,8 @@ using BigInt = DynamicLongInt<true, uint64_t>;
 extern "C" {
 #endif
 
+struct FloatOps;
+
 struct Float {
   enum class Value {
     Normal = 0,
@@ -19,6 +21,12 @@ struct Float {
   BigInt mantissa;
   BigInt pow_2_mantissa_bits;
 
+  // Preallocated intermediates of the arithmetic, so that it allocates nothing per call.
+  BigInt scratch_lhs;
+  BigInt scratch_rhs;
+  BigInt scratch_remainder;
+  BigInt scratch_work;
+
   int exponent_bits = 0;
   int mantissa_bits = 0;
   int size_of_big_int = 0;
@@ -26,9 +34,17 @@ struct Float {
   Value value = Value::Denormal;
   bool sign = false;
 
+  // Implementations picked by float_init for the format: native words when it fits 64 or
+  // 128 bits, LongInt digits otherwise.
+  const FloatOps* ops = nullptr;
+
   Float() : exponent(BigInt::with_digits(1)),
             mantissa(BigInt::with_digits(1)),
-            pow_2_mantissa_bits(BigInt::with_digits(1)) {}
+            pow_2_mantissa_bits(BigInt::with_digits(1)),
+            scratch_lhs(BigInt::with_digits(1)),
+            scratch_rhs(BigInt::with_digits(1)),
+            scratch_remainder(BigInt::with_digits(1)),
+            scratch_work(BigInt::with_digits(1)) {}
 };
 
 typedef struct Float Float;
@@ -47,6 +63,11 @@ void float_set_sign(Float* self, bool sign);
 void float_set_exponent(Float* self, const void* exponent);
 void float_set_mantissa(Float* self, const void* mantissa);
 
+// The encoding as one word, sign above the exponent above the mantissa, for formats of up to
+// 64 bits. For float32 and float64 it is the IEEE bit pattern.
+uint64_t float_get_bits(const Float* self);
+void float_set_bits(Float* self, uint64_t bits);
+
 void float_add(Float* result, const Float* a, const Float* b);
 void float_sub(Float* result, const Float* a, const Float* b);
 void float_mul(Float* result, const Float* a, const Float* b);
@@ -55,6 +76,16 @@ void float_div(Float* result, const Float* a, const Float* b);
 void float_next(Float* self);
 void float_prev(Float* self);
 
+// The operations over arrays of n values of one format, result[i] = a[i] op b[i]. Formats of
+// up to 32 bits run on their packed encodings several values at a time.
+void float_add_n(Float* result, const Float* a, const Float* b, size_t n);
+void float_sub_n(Float* result, const Float* a, const Float* b, size_t n);
+void float_mul_n(Float* result, const Float* a, const Float* b, size_t n);
+void float_div_n(Float* result, const Float* a, const Float* b, size_t n);
+
+void float_next_n(Float* self, size_t n);
+void float_prev_n(Float* self, size_t n);
+
 void float_parse(Float* self, const char* string);
 int float_string(const Float* self, char* string, int n);
 
@@ -0,0 +1,81 @@
+#include "utils.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<Float> make_floats(int exponent_bits, int mantissa_bits, size_t n) {
+    std::vector<Float> floats(n);
+    for (Float& flt : floats) {
+        float_init(&flt, exponent_bits, mantissa_bits);
+    }
+    return floats;
+}
+
+bool same_fields(const Float* a, const Float* b) {
+    uint64_t exponent_a = 0, exponent_b = 0, mantissa_a = 0, mantissa_b = 0;
+    float_get_exponent(a, &exponent_a);
+    float_get_exponent(b, &exponent_b);
+    float_get_mantissa(a, &mantissa_a);
+    float_get_mantissa(b, &mantissa_b);
+    return float_get_sign(a) == float_get_sign(b) && exponent_a == exponent_b && mantissa_a == mantissa_b;
+}
+
+// Fills a and b with every pair of values for formats of at most 8 bits, with random values otherwise.
+void fill_pairs(std::vector<Float>& a, std::vector<Float>& b, int exponent_bits, int mantissa_bits) {
+    std::mt19937_64 rng(42);
+    int bits = exponent_bits + mantissa_bits + 1;
+    for (size_t i = 0; i < a.size(); i++) {
+        uint64_t encoding_a = bits <= 8 ? i >> bits : rng();
+        uint64_t encoding_b = bits <= 8 ? i : rng();
+        set_float(&a[i], (encoding_a >> (bits - 1)) & 1, (encoding_a >> mantissa_bits) & ((1ull << exponent_bits) - 1),
+                  encoding_a & ((1ull << mantissa_bits) - 1));
+        set_float(&b[i], (encoding_b >> (bits - 1)) & 1, (encoding_b >> mantissa_bits) & ((1ull << exponent_bits) - 1),
+                  encoding_b & ((1ull << mantissa_bits) - 1));
+    }
+}
+
+} // namespace
+
+// The array operations give what the single ones do, for the formats of tests_float8.cpp and
+// tests_float32.cpp and one past 32 bits.
+TEST(test_batch_matches_single, Suite::mul()) {
+    int formats[][2] = {{3, 4}, {8, 23}, {11, 52}};
+    for (auto [exponent_bits, mantissa_bits] : formats) {
+        size_t n = exponent_bits + mantissa_bits + 1 <= 8 ? 1 << (2 * (exponent_bits + mantissa_bits + 1)) : 10007;
+        std::vector<Float> a = make_floats(exponent_bits, mantissa_bits, n);
+        std::vector<Float> b = make_floats(exponent_bits, mantissa_bits, n);
+        std::vector<Float> batch = make_floats(exponent_bits, mantissa_bits, n);
+        Float single = {};
+        float_init(&single, exponent_bits, mantissa_bits);
+        fill_pairs(a, b, exponent_bits, mantissa_bits);
+
+        FloatBinOp* singles[] = {float_add, float_sub, float_mul, float_div};
+        void (*batches[])(Float*, const Float*, const Float*, size_t) = {float_add_n, float_sub_n, float_mul_n,
+                                                                         float_div_n};
+        for (int op = 0; op < 4; op++) {
+            batches[op](batch.data(), a.data(), b.data(), n);
+            for (size_t i = 0; i < n; i++) {
+                singles[op](&single, &a[i], &b[i]);
+                if (EXPECT(same_fields(&single, &batch[i]))
+                    << "Operation " << op << " on array element " << i << " of format (" << exponent_bits << ", "
+                    << mantissa_bits << ") differs from the single one")
+                    return;
+            }
+        }
+
+        for (int step = 0; step < 2; step++) {
+            batch = a;
+            (step == 0 ? float_next_n : float_prev_n)(batch.data(), n);
+            for (size_t i = 0; i < n; i++) {
+                single = a[i];
+                (step == 0 ? float_next : float_prev)(&single);
+                if (EXPECT(same_fields(&single, &batch[i]))
+                    << (step == 0 ? "float_next_n" : "float_prev_n") << " on array element " << i << " of format ("
+                    << exponent_bits << ", " << mantissa_bits << ") differs from the single one")
+                    return;
+            }
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#include "utils.h"
+
+#include "FloatValues.hpp"
+
+#include <charconv>
+#include <random>
+#include <string>
+
+namespace {
+
+std::string to_string(const Float* flt) {
+    std::string text(float_string(flt, nullptr, 0), '\0');
+    float_string(flt, text.data(), (int)text.size());
+    return text;
+}
+
+// The significant digits of a decimal string, without leading and trailing zeroes.
+std::string significant_digits(std::string_view text) {
+    std::string digits;
+    for (char c : text.substr(0, text.find_first_of("eE"))) {
+        if (c >= '0' && c <= '9' && (c != '0' || !digits.empty())) {
+            digits += c;
+        }
+    }
+    return digits.substr(0, digits.find_last_not_of('0') + 1);
+}
+
+} // namespace
+
+// Every value of a few small formats, which also take FastDecimal, reads back from its string.
+// The largest finite value is its own bound above, as parsing overflows past it.
+TEST(test_decimal_round_trip, Suite::string()) {
+    int formats[][2] = {{3, 4}, {4, 3}, {5, 10}};
+    for (auto [exponent_bits, mantissa_bits] : formats) {
+        Float parsed = {};
+        float_init(&parsed, exponent_bits, mantissa_bits);
+        for (const Float& value : FloatValues(exponent_bits, mantissa_bits)) {
+            std::string text = to_string(&value);
+            float_parse(&parsed, text.c_str());
+            uint64_t bits = float_get_bits(&value);
+            bool nan = ((bits >> mantissa_bits) & ((1ull << exponent_bits) - 1)) == (1ull << exponent_bits) - 1 &&
+                       (bits & ((1ull << mantissa_bits) - 1)) != 0;
+            if (EXPECT((nan ? text == "NaN" : float_get_bits(&parsed) == bits))
+                << "'" << text << "' does not read back as value " << bits << " of format ("
+                << exponent_bits << ", " << mantissa_bits << ")")
+                return;
+        }
+        float_destroy(&parsed);
+    }
+}
+
+// The strings of double have the digits std::to_chars gives, and digits past the ones of a
+// halfway point decide the rounding only by being nonzero.
+TEST(test_decimal_shortest, Suite::string()) {
+    std::mt19937_64 rng(24);
+    Float flt = {};
+    float_init(&flt, 11, 52);
+    for (int i = 0; i < 10000; i++) {
+        double value = 0;
+        uint64_t bits = rng();
+        std::memcpy(&value, &bits, sizeof(value));
+        if (!std::isfinite(value) || value == 0) {
+            continue;
+        }
+        float_set_bits(&flt, bits);
+        std::string text = to_string(&flt);
+        char expected[64];
+        char* end = std::to_chars(expected, expected + sizeof(expected), value, std::chars_format::scientific).ptr;
+        if (EXPECT(significant_digits(text) == significant_digits(std::string_view(expected, end - expected)))
+            << "float_string gives '" << text << "' for " << std::string(expected, end))
+            return;
+    }
+
+    float_destroy(&flt);
+
+    test_parse(8, 23, "16777217", 0, 0x97, 0x000000);
+    test_parse(8, 23, "16777217.000000000000000000000001", 0, 0x97, 0x000001);
+    test_parse(8, 23, "1.00000005960464477539062500000000000000000000000000000001", 0, 0x7f, 0x000001);
+    test_parse(8, 23, "340282346638528859811704183484516925440", 0, 0xfe, 0x7fffff);
+    test_parse(8, 23, "340282346638528859811704183484516925440.001", 0, 0xff, 0x000000);
+}
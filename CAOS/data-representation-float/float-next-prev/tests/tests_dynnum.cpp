@@ -0,0 +1,72 @@
+#include "utils.h"
+
+#include "Conversion.hpp"
+
+#include <random>
+#include <string>
+
+namespace {
+
+DynNum<> random_number(std::mt19937_64& rng, int digits, int dot_index) {
+    std::string text(digits, '0');
+    for (char& c : text) {
+        c = (char)('0' + rng() % 10);
+    }
+    text[0] = (char)('1' + rng() % 9);
+    return DynNum<>(rng() & 1, dot_index, text);
+}
+
+} // namespace
+
+// Products past the Karatsuba threshold, balanced and not, agree with the identities schoolbook
+// products of the same numbers satisfy, and thousands of digits print back as they were read.
+TEST(test_dynnum_mul, Suite::mul()) {
+    DynNum<> product = DynNum<>("123456789123456789") * DynNum<>("-987654321.987654321");
+    if (EXPECT(product == DynNum<>("-121932631356500531347203169.112635269")) << "Got " << product.to_string())
+        return;
+
+    std::mt19937_64 rng(25);
+    for (int digits : {20, 400, 3000}) {
+        DynNum<> a = random_number(rng, digits, digits / 3);
+        DynNum<> b = random_number(rng, digits, -7);
+        DynNum<> c = random_number(rng, digits / 8 + 1, 5);
+        if (EXPECT((a + b) * (a - b) == a * a - b * b) << "(a + b)(a - b) differs at " << digits << " digits")
+            return;
+        if (EXPECT(a * (b + c) == a * b + a * c) << "a (b + c) differs at " << digits << " digits")
+            return;
+
+        std::string text = a.to_string();
+        if (EXPECT(DynNum<>(text.c_str()).to_string() == text) << "'" << text << "' does not read back")
+            return;
+    }
+}
+
+// Quotients are the leading digits of the exact ones, by long division for short divisors and by
+// the Newton reciprocal for long ones.
+TEST(test_dynnum_div, Suite::div()) {
+    if (EXPECT(DynNum<>::divide(DynNum<>("1"), DynNum<>("3"), 10) == DynNum<>("0.3333333333")) << "1 / 3")
+        return;
+    if (EXPECT(DynNum<>::divide(DynNum<>("-22"), DynNum<>("7"), 5) == DynNum<>("-3.1428")) << "-22 / 7")
+        return;
+    if (EXPECT(DynNum<>("8e-3").reciprocal(4) == DynNum<>("125")) << "1 / 0.008")
+        return;
+    if (EXPECT(DynNum<>::divide(DynNum<>("99"), DynNum<>("2"), 1) == DynNum<>("40")) << "99 / 2")
+        return;
+
+    std::mt19937_64 rng(25);
+    for (int digits : {5, 200, 3000}) {
+        DynNum<> a = random_number(rng, digits, 11);
+        DynNum<> b = random_number(rng, digits, -digits);
+        DynNum<> quotient = DynNum<>::divide(a * b, b, digits);
+        if (EXPECT(quotient == a) << "a b / b differs at " << digits << " digits")
+            return;
+
+        a.sign = b.sign = false;
+        int precision = digits + 17;
+        quotient = DynNum<>::divide(a, b, precision);
+        DynNum<> unit(false, quotient.dot_index() - precision + 1, "1");
+        if (EXPECT(quotient.digit_count() <= precision && quotient * b <= a && a < (quotient + unit) * b)
+            << "a / b is not truncated at " << precision << " digits")
+            return;
+    }
+}
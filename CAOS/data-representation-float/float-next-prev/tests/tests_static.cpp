@@ -0,0 +1,60 @@
+#include "utils.h"
+
+#include "StaticFloat.hpp"
+
+// StaticFloat evaluates in constant expressions.
+static_assert(identical(Float32::parse("0.1") * Float32::parse("10"), Float32::parse("1")));
+static_assert(identical(Float64::parse("1.5") + Float64::parse("2.25"), Float64::parse("3.75")));
+static_assert(identical(Float8E5M2::parse("-Inf"), Float8E5M2::inf(true)));
+static_assert(identical(BFloat16::parse("1") / BFloat16::parse("0"), BFloat16::inf(false)));
+static_assert(identical(Float8E4M3(false, 0, 0).next(), Float8E4M3(false, 0, 1)));
+static_assert(identical(Float16(true, 0, 0).next(), Float16(false, 0, 0)));
+
+// Every pair of values of the float8 from tests_float8.cpp gives the same fields as the C API.
+TEST(test_static_float8_matches_c_api, Suite::mul()) {
+    using Float8 = StaticFloat<3, 4>;
+    Float a = {}, b = {}, result = {};
+    if (float_init(&a, 3, 4) < 0 || float_init(&b, 3, 4) < 0 || float_init(&result, 3, 4) < 0)
+        HANDLE_FAIL(float_init);
+
+    auto same = [](const Float8& expected, const Float* flt) {
+        uint64_t exponent = 0, mantissa = 0;
+        float_get_exponent(flt, &exponent);
+        float_get_mantissa(flt, &mantissa);
+        return expected.sign() == float_get_sign(flt) && (uint64_t)expected.exponent() == exponent &&
+               expected.mantissa() == mantissa;
+    };
+
+    for (int i = 0; i < 256; i++) {
+        Float8 static_a((i >> 7) & 1, (i >> 4) & 7, i & 15);
+        set_float(&a, static_a.sign(), static_a.exponent(), static_a.mantissa());
+
+        Float8 next = static_a;
+        Float copy = a;
+        float_next(&copy);
+        if (EXPECT(same(next.next(), &copy)) << "next differs for bits " << i)
+            return;
+
+        for (int j = 0; j < 256; j++) {
+            Float8 static_b((j >> 7) & 1, (j >> 4) & 7, j & 15);
+            set_float(&b, static_b.sign(), static_b.exponent(), static_b.mantissa());
+
+            float_add(&result, &a, &b);
+            if (EXPECT(same(static_a + static_b, &result)) << "add differs for bits " << i << ", " << j)
+                return;
+            float_sub(&result, &a, &b);
+            if (EXPECT(same(static_a - static_b, &result)) << "sub differs for bits " << i << ", " << j)
+                return;
+            float_mul(&result, &a, &b);
+            if (EXPECT(same(static_a * static_b, &result)) << "mul differs for bits " << i << ", " << j)
+                return;
+            float_div(&result, &a, &b);
+            if (EXPECT(same(static_a / static_b, &result)) << "div differs for bits " << i << ", " << j)
+                return;
+        }
+    }
+
+    float_destroy(&a);
+    float_destroy(&b);
+    float_destroy(&result);
+}
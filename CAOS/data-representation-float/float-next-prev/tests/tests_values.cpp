@@ -0,0 +1,48 @@
+#include "utils.h"
+
+#include "FloatValues.hpp"
+
+#include <atomic>
+
+// Stepping through the encodings visits what float_next does from +0 up to +inf, and the
+// parallel sweep sees every encoding once.
+TEST(test_values_match_next, Suite::prev_next()) {
+    int formats[][2] = {{3, 4}, {2, 1}, {5, 10}};
+    for (auto [exponent_bits, mantissa_bits] : formats) {
+        FloatValues values(exponent_bits, mantissa_bits);
+        uint64_t inf_bits = (((uint64_t)1 << exponent_bits) - 1) << mantissa_bits;
+
+        Float expected = {};
+        float_init(&expected, exponent_bits, mantissa_bits);
+        uint64_t count = 0;
+        for (auto it = values.begin(); it != values.end(); ++it) {
+            if (EXPECT(float_get_bits(&*it) == it.encoding())
+                << "Value " << it.encoding() << " of format (" << exponent_bits << ", " << mantissa_bits
+                << ") has other bits")
+                return;
+            if (it.encoding() <= inf_bits) {
+                uint64_t expected_bits = float_get_bits(&expected);
+                if (EXPECT(it.encoding() == expected_bits)
+                    << "float_next gives another value in format (" << exponent_bits << ", " << mantissa_bits << ")")
+                    return;
+                float_next(&expected);
+            }
+            count++;
+        }
+        if (EXPECT(count == values.size()) << "The range misses values")
+            return;
+
+        std::atomic<uint64_t> swept = 0, sum = 0;
+        values.sweep(
+            [&](const Float& value) {
+                swept++;
+                sum += float_get_bits(&value);
+            },
+            4, 100);
+        if (EXPECT(swept.load() == values.size()) << "The sweep misses values")
+            return;
+        if (EXPECT(sum.load() == values.size() * (values.size() - 1) / 2) << "The sweep repeats values")
+            return;
+        float_destroy(&expected);
+    }
+}